@@ -50,7 +50,9 @@ enum asset_tag_id {
 
 #define HHA_CODE(a,b,c,d) (((uint32)(a) << 0) | ((uint32)(b) << 8) | ((uint32)(c) << 16) | ((uint32)(d) << 24))
 #define HHA_MAGIC_VALUE HHA_CODE('h','h','a','f')
-#define HHA_VERSION 0
+// NOTE(sen) 1 - bitmaps carry their mip chain
+// NOTE(sen) 2 - bitmaps carry coverage after the mip chain
+#define HHA_VERSION 2
 
 struct sound_id {
     uint32 Value;
@@ -95,6 +97,30 @@ enum hha_sound_chain {
 struct hha_bitmap {
     uint32 Dim[2];
     real32 AlignPercentage[2];
+    // NOTE(sen) Levels stored back to back starting with the full size one, version 1 and up
+    uint32 MipCount;
+};
+
+enum hha_bitmap_flags {
+    HHABitmap_Opaque = 0x1, // NOTE(sen) Every texel has full alpha
+};
+
+/// Follows the mip chain from version 2, Height hha_bitmap_row_span follow it. Texels with 0 alpha
+/// are transparent. All of it is in texels of the full size level.
+struct hha_bitmap_coverage {
+    // NOTE(sen) Tightest rect around the texels that aren't transparent, empty if they all are
+    uint16 TrimMin[2];
+    uint16 TrimMax[2];
+    uint32 Flags;
+};
+
+struct hha_bitmap_row_span {
+    // NOTE(sen) From the first texel in the row that isn't transparent to one past the last
+    uint16 MinX;
+    uint16 MaxX;
+    // NOTE(sen) Longest run of texels with full alpha
+    uint16 OpaqueMinX;
+    uint16 OpaqueMaxX;
 };
 
 struct hha_sound {
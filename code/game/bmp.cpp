@@ -5,6 +5,7 @@
 #include "../intrinsics.h"
 #include "lib.hpp"
 #include "math.cpp"
+#include "../file_formats.h"
 
 #pragma pack(push, 1)
 struct bitmap_header {
@@ -38,6 +39,16 @@ struct loaded_bitmap {
     int32 Width;
     int32 Height;
     int32 Pitch;
+    // NOTE(sen) Every texel has full alpha, drawn with full alpha it hides whatever is under it
+    bool32 Opaque;
+    // NOTE(sen) Smaller levels follow the full size one in Memory (see mip.cpp), 0 or 1 means there are none
+    uint32 MipCount;
+    // NOTE(sen) Texels in 4x4 blocks instead of rows, Pitch is then the bytes in a row of blocks
+    bool32 Tiled;
+    // NOTE(sen) Which texels of the full size level are transparent/opaque, row spans follow it. 0 if we don't know
+    hha_bitmap_coverage* Coverage;
+    // NOTE(sen) Level of the chain this is when it came out of GetMipLevel
+    uint32 MipLevel;
 };
 
 
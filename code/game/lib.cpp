@@ -207,13 +207,14 @@ MakeNullCollision(game_state* GameState) {
 
 internal void ClearBitmap(loaded_bitmap* Bitmap) {
     if (Bitmap->Memory) {
-        int32 TotalBitmapSize = Bitmap->Width * Bitmap->Height * BITMAP_BYTES_PER_PIXEL;
+        int32 TotalBitmapSize =
+            GetMipChainTexelCount(Bitmap->Width, Bitmap->Height, Maximum(Bitmap->MipCount, 1)) * BITMAP_BYTES_PER_PIXEL;
         ZeroSize(TotalBitmapSize, Bitmap->Memory);
     }
 }
 
 internal loaded_bitmap
-MakeEmptyBitmap(memory_arena* Arena, int32 Width, int32 Height, bool32 ClearToZero = true) {
+MakeEmptyBitmap(memory_arena* Arena, int32 Width, int32 Height, bool32 ClearToZero = true, bool32 Mipmapped = false) {
 
     loaded_bitmap Result = {};
 
@@ -222,8 +223,10 @@ MakeEmptyBitmap(memory_arena* Arena, int32 Width, int32 Height, bool32 ClearToZe
     Result.Pitch = Width * BITMAP_BYTES_PER_PIXEL;
     Result.AlignPercentage = V2(0.5f, 0.5f);
     Result.WidthOverHeight = SafeRatio1((real32)Result.Width, (real32)Result.Height);
+    Result.MipCount = Mipmapped ? GetMipCount(Width, Height) : 1;
 
-    int32 TotalBitmapSize = Width * Height * BITMAP_BYTES_PER_PIXEL;
+    // NOTE(sen) Room for the whole chain, whoever draws into the bitmap calls BuildMipChain after
+    int32 TotalBitmapSize = GetMipChainTexelCount(Width, Height, Result.MipCount) * BITMAP_BYTES_PER_PIXEL;
     Result.Memory = PushSize(Arena, TotalBitmapSize, 16);
 
     if (ClearToZero) {
@@ -357,9 +360,15 @@ internal void EndTaskWithMemory(task_with_memory* Task) {
     Task->BeingUsed = false;
 }
 
+// NOTE(sen) Store loaded bitmaps in 4x4 blocks so the bilinear taps of rotated sprites stay in one
+// or two cache lines (see TileMipChain). Off for now, with mips the row layout already stays in
+// cache and the block offsets cost more than the misses they save
+global_variable bool32 GlobalTileLoadedBitmaps = false;
+
 enum finalize_asset_operation {
     FinalizeAsset_None,
     FinalizeAsset_Font,
+    FinalizeAsset_Bitmap,
 };
 
 struct load_asset_work {
@@ -389,11 +398,28 @@ LoadAssetWorkDirectly(load_asset_work* Work) {
                 Font->UnicodeMap[Glyph->UnicodeCodepoint] = (uint16)GlyphIndex;
             }
         } break;
+        case FinalizeAsset_Bitmap: {
+            loaded_bitmap* Bitmap = &Work->Asset->Header->Bitmap;
+            if (Bitmap->Tiled) {
+                Assert(Work->Task);
+                uint32* Scratch = PushArray(&Work->Task->Arena, TEXEL_BLOCK_SIDE * Bitmap->Width, uint32);
+                TileMipChain((uint32*)Bitmap->Memory, Bitmap->Width, Bitmap->Height, Bitmap->MipCount, Scratch);
+            }
+            if (Bitmap->Coverage) {
+                Bitmap->Opaque = (Bitmap->Coverage->Flags & HHABitmap_Opaque) != 0;
+            }
+        } break;
         }
     }
     CompletePreviousWritesBeforeFutureWrites;
     if (!PlatformNoFileErrors(Work->Handle)) {
-        ZeroSize(Work->Size, Work->Destination);
+        if (Work->FinalizeOperation == FinalizeAsset_Bitmap) {
+            // NOTE(sen) The rows were read into the end of the bitmap, clear the front as well
+            loaded_bitmap* Bitmap = &Work->Asset->Header->Bitmap;
+            ZeroSize((uint8*)Work->Destination + Work->Size - (uint8*)Bitmap->Memory, Bitmap->Memory);
+        } else {
+            ZeroSize(Work->Size, Work->Destination);
+        }
     }
     Work->Asset->State = Work->FinalState;
 }
@@ -430,12 +456,27 @@ internal void LoadBitmap(game_assets* Assets, bitmap_id ID, bool32 Immediate) {
                 hha_asset* HHAAsset = &Asset->HHA;
                 hha_bitmap* Info = &HHAAsset->Bitmap;
 
+                uint32 FileVersion = GetFile(Assets, Asset->FileIndex)->Header.Version;
+                uint32 MipCount = 1;
+                if (FileVersion >= 1) {
+                    MipCount = Maximum(Info->MipCount, 1);
+                }
+
                 asset_memory_size Size = {};
                 uint32 Width = Info->Dim[0];
                 uint32 Height = Info->Dim[1];
-                Size.Section = Width * 4;
-                Size.Data = Size.Section * Height;
+                // NOTE(sen) Tiling takes scratch rows from the task's arena, immediate loads stay in rows
+                bool32 Tiled = GlobalTileLoadedBitmaps && Task;
+                uint32 CoverageSize = 0;
+                if (FileVersion >= 2) {
+                    CoverageSize = sizeof(hha_bitmap_coverage) + Height * sizeof(hha_bitmap_row_span);
+                }
+                Size.Section = Tiled ? GetTiledPitch(Width) : Width * 4;
+                Size.Data = GetMipChainTexelCount(Width, Height, MipCount, Tiled) * 4 + CoverageSize;
                 Size.Total = Size.Data + sizeof(asset_memory_header);
+                // NOTE(sen) Rows as they are in the file, read into the end of the tiled bitmap when we tile.
+                // Coverage ends up right after the chain either way.
+                uint32 FileDataSize = GetMipChainTexelCount(Width, Height, MipCount) * 4 + CoverageSize;
 
                 Asset->Header = (asset_memory_header*)AcquireAssetMemory(Assets, Size.Total, ID.Value);
 
@@ -447,15 +488,23 @@ internal void LoadBitmap(game_assets* Assets, bitmap_id ID, bool32 Immediate) {
                 Bitmap->WidthOverHeight = (real32)Bitmap->Width / (real32)Bitmap->Height;
                 Bitmap->Pitch = Size.Section;
                 Bitmap->Memory = Asset->Header + 1;
+                Bitmap->Opaque = false;
+                Bitmap->MipCount = MipCount;
+                Bitmap->Tiled = Tiled;
+                Bitmap->Coverage = 0;
+                if (CoverageSize) {
+                    Bitmap->Coverage = (hha_bitmap_coverage*)((uint8*)Bitmap->Memory + Size.Data - CoverageSize);
+                }
+                Bitmap->MipLevel = 0;
 
                 load_asset_work Work;
                 Work.Task = Task;
                 Work.Asset = Assets->Assets + ID.Value;
                 Work.Handle = GetFileHandleFor(Assets, Asset->FileIndex);
                 Work.Offset = HHAAsset->DataOffset;
-                Work.Size = Size.Data;
-                Work.Destination = Bitmap->Memory;
-                Work.FinalizeOperation = FinalizeAsset_None;
+                Work.Size = FileDataSize;
+                Work.Destination = (uint8*)Bitmap->Memory + Size.Data - FileDataSize;
+                Work.FinalizeOperation = FinalizeAsset_Bitmap;
                 Work.FinalState = AssetState_Loaded;
                 if (Task) {
                     load_asset_work* TaskWork = PushStruct(&Task->Arena, load_asset_work);
@@ -667,6 +716,9 @@ internal PLATFORM_WORK_QUEUE_CALLBACK(FillGroundChunkWork) {
 
     Assert(AllResourcesPresent(RenderGroup));
     RenderGroupToOutput(RenderGroup, Buffer);
+    BuildMipChain((uint32*)Buffer->Memory, Buffer->Width, Buffer->Height, Buffer->MipCount);
+    // NOTE(sen) Starts from an opaque clear and stays opaque from then on, refills included
+    Buffer->Opaque = true;
     EndRender(RenderGroup);
     EndTaskWithMemory(Work->Task);
 }
@@ -865,7 +917,7 @@ internal void DEBUGOverlay(game_memory* Memory, game_input* Input) {
                 if (Counter->BlockName) {
 
                     char TextBuffer[256];
-                    _snprintf_s(
+                    snprintf(
                         TextBuffer, sizeof(TextBuffer),
                         "%20s(%4d): %10ucy %10uh %10ucy/h\n",
                         Counter->BlockName, Counter->Linenumber, (uint32)CycleCount.Avg, (uint32)HitCount.Avg, (uint32)(CyclesPerHit.Avg)
@@ -889,13 +941,22 @@ internal void DEBUGOverlay(game_memory* Memory, game_input* Input) {
 #endif
             if (DebugState->FrameCount) {
                 char TextBuffer[256];
-                _snprintf_s(
+                snprintf(
                     TextBuffer, sizeof(TextBuffer),
                     "Last frame time: %.02fms\n",
                     DebugState->Frames[DebugState->FrameCount - 1].WallSecondsElapsed * 1000.0f
                 );
                 DEBUGTextLine(TextBuffer);
             }
+            transient_state* TranState = (transient_state*)Memory->TransientStorage;
+            if (TranState->IsInitialized) {
+                char TextBuffer[256];
+                snprintf(
+                    TextBuffer, sizeof(TextBuffer),
+                    "Culled entries: %u\n", TranState->WorldCulledEntryCount
+                );
+                DEBUGTextLine(TextBuffer);
+            }
 #if 1
             real32 LaneHeight = 20.0f;
             real32 LaneCount = (real32)DebugState->FrameBarLaneCount;
@@ -956,11 +1017,11 @@ internal void DEBUGOverlay(game_memory* Memory, game_input* Input) {
                     if (IsInRectangle(RegionRect, MouseP)) {
                         debug_record* Record = Region->Record;
                         char TextBuffer[256];
-                        _snprintf_s(
+                        snprintf(
                             TextBuffer, sizeof(TextBuffer),
-                            "%s: %10Iucy [%s(%d)]",
+                            "%s: %10llucy [%s(%d)]",
                             Record->BlockName,
-                            Region->CycleCount,
+                            (unsigned long long)Region->CycleCount,
                             Record->Filename, Record->Linenumber
                         );
                         DEBUGTextOutAt(MouseP + V2(0.0f, 10.f), TextBuffer);
@@ -993,6 +1054,9 @@ internal void DEBUGOverlay(game_memory* Memory, game_input* Input) {
     }
 }
 
+// NOTE(sen) Pipeline for the main render group, see SetRenderPipeline
+global_variable render_pipeline GlobalRenderPipeline = RenderPipeline_Float;
+
 extern "C" GAME_UPDATE_AND_RENDER(GameUpdateAndRender) {
     Platform = Memory->PlatformAPI;
 #if HANDMADE_INTERNAL
@@ -1208,6 +1272,9 @@ extern "C" GAME_UPDATE_AND_RENDER(GameUpdateAndRender) {
 
         DEBUGRenderGroup = AllocateRenderGroup(TranState->Assets, &TranState->TranArena, Megabytes(16), false);
 
+        TranState->WorldTileSchedule = AllocateRenderTileSchedule(&TranState->TranArena, Memory->HighPriorityThreadCount);
+        TranState->DEBUGTileSchedule = AllocateRenderTileSchedule(&TranState->TranArena, Memory->HighPriorityThreadCount);
+
         GameState->Music = PlaySound(&GameState->AudioState, GetFirstSoundFrom(TranState->Assets, Asset_Music));
         ChangeVolume(&GameState->AudioState, GameState->Music, 0.1f, V2(0.1f, 0.1f));
 
@@ -1221,7 +1288,7 @@ extern "C" GAME_UPDATE_AND_RENDER(GameUpdateAndRender) {
 
             ground_buffer* GroundBuffer = TranState->GroundBuffers + GroundBufferIndex;
             GroundBuffer->Bitmap = MakeEmptyBitmap(
-                &TranState->TranArena, GroundBufferWidth, GroundBufferHeight, false
+                &TranState->TranArena, GroundBufferWidth, GroundBufferHeight, false, true
             );
             GroundBuffer->P = NullPosition();
         }
@@ -1365,6 +1432,7 @@ extern "C" GAME_UPDATE_AND_RENDER(GameUpdateAndRender) {
     DrawBuffer->Memory = Buffer->Memory;
 
     render_group* RenderGroup = AllocateRenderGroup(TranState->Assets, &TranState->TranArena, Megabytes(4), false);
+    SetRenderPipeline(RenderGroup, GlobalRenderPipeline);
     BeginRender(RenderGroup);
 
     real32 WidthOfMonitor = 0.635f;
@@ -1914,7 +1982,8 @@ extern "C" GAME_UPDATE_AND_RENDER(GameUpdateAndRender) {
     PushBitmap(DEBUGRenderGroup, TempBitmap, 60.0f, V3(7.0f, 0.0f, 0.0f), V4(1, 1, 1, 1));
 #endif
 
-    TiledRenderGroupToOutput(TranState->HighPriorityQueue, RenderGroup, DrawBuffer);
+    TiledRenderGroupToOutput(TranState->HighPriorityQueue, RenderGroup, DrawBuffer, TranState->WorldTileSchedule);
+    TranState->WorldCulledEntryCount = RenderGroup->CulledEntryCount;
     EndRender(RenderGroup);
 
     EndSim(SimRegion, GameState);
@@ -1930,7 +1999,7 @@ extern "C" GAME_UPDATE_AND_RENDER(GameUpdateAndRender) {
     DEBUGOverlay(Memory, Input);
 
     if (DEBUGRenderGroup) {
-        TiledRenderGroupToOutput(TranState->HighPriorityQueue, DEBUGRenderGroup, DrawBuffer);
+        TiledRenderGroupToOutput(TranState->HighPriorityQueue, DEBUGRenderGroup, DrawBuffer, TranState->DEBUGTileSchedule);
         EndRender(DEBUGRenderGroup);
     }
 }
@@ -5,6 +5,8 @@
 #if !defined(COMPILER_MSVC) && !defined(COMPILER_LLVM)
 #if _MSC_VER
 #define COMPILER_MSVC 1
+#elif defined(__clang__) || defined(__GNUC__)
+#define COMPILER_LLVM 1
 #endif
 #endif
 
@@ -113,6 +115,7 @@ struct game_memory {
 
     platform_work_queue* HighPriorityQueue;
     platform_work_queue* LowPriorityQueue;
+    uint32 HighPriorityThreadCount;
 
     platform_api PlatformAPI;
 };
@@ -0,0 +1,126 @@
+#if !defined(HANDMADE_MIP_CPP)
+#define HANDMADE_MIP_CPP
+
+#include "../types.h"
+#include "math.cpp"
+
+/// Number of levels including the full size one. Levels halve (rounding down) until either side
+/// would drop below 2 texels, the bilinear fetch always reads a 2x2 block.
+internal uint32 GetMipCount(uint32 Width, uint32 Height) {
+    uint32 Result = 1;
+    while (Width >= 4 && Height >= 4) {
+        Width /= 2;
+        Height /= 2;
+        ++Result;
+    }
+    return Result;
+}
+
+// NOTE(sen) Tiled levels are stored as 4x4 blocks of texels (64 bytes, one cache line), a row of blocks at a time
+#define TEXEL_BLOCK_SIDE 4
+
+/// Tiled levels get padded out to whole blocks
+internal uint32 GetMipLevelTexelCount(uint32 Width, uint32 Height, bool32 Tiled) {
+    uint32 Result = Width * Height;
+    if (Tiled) {
+        Result =
+            ((Width + TEXEL_BLOCK_SIDE - 1) & ~(TEXEL_BLOCK_SIDE - 1)) *
+            ((Height + TEXEL_BLOCK_SIDE - 1) & ~(TEXEL_BLOCK_SIDE - 1));
+    }
+    return Result;
+}
+
+/// Bytes in a row of blocks of a tiled level
+internal uint32 GetTiledPitch(uint32 Width) {
+    uint32 Result = ((Width + TEXEL_BLOCK_SIDE - 1) / TEXEL_BLOCK_SIDE) * TEXEL_BLOCK_SIDE * TEXEL_BLOCK_SIDE * sizeof(uint32);
+    return Result;
+}
+
+/// Texels in all the levels of a chain, packed one after the other with no padding in between
+internal uint32 GetMipChainTexelCount(uint32 Width, uint32 Height, uint32 MipCount, bool32 Tiled = false) {
+    uint32 Result = 0;
+    for (uint32 Level = 0; Level < MipCount; ++Level) {
+        Result += GetMipLevelTexelCount(Width >> Level, Height >> Level, Tiled);
+    }
+    return Result;
+}
+
+internal v4 UnpackMipTexel(uint32 Packed) {
+    v4 Result = V4(
+        (real32)((Packed >> 16) & 0xFF),
+        (real32)((Packed >> 8) & 0xFF),
+        (real32)((Packed >> 0) & 0xFF),
+        (real32)((Packed >> 24) & 0xFF)
+    );
+    return Result;
+}
+
+/// 2x2 box filter, averaged in linear space. Texels are premultiplied so edges don't pick up
+/// the color of transparent neighbours. Odd sizes lose the last row/column.
+internal void DownsampleMip(uint32* Source, uint32 SourceWidth, uint32 SourceHeight, uint32* Dest) {
+    uint32 DestWidth = SourceWidth / 2;
+    uint32 DestHeight = SourceHeight / 2;
+    for (uint32 Y = 0; Y < DestHeight; ++Y) {
+        uint32* SourceRow0 = Source + (2 * Y) * SourceWidth;
+        uint32* SourceRow1 = SourceRow0 + SourceWidth;
+        for (uint32 X = 0; X < DestWidth; ++X) {
+            v4 Sum =
+                SRGB255ToLinear1(UnpackMipTexel(SourceRow0[2 * X])) +
+                SRGB255ToLinear1(UnpackMipTexel(SourceRow0[2 * X + 1])) +
+                SRGB255ToLinear1(UnpackMipTexel(SourceRow1[2 * X])) +
+                SRGB255ToLinear1(UnpackMipTexel(SourceRow1[2 * X + 1]));
+            v4 Texel = Linear1ToSRGB255(0.25f * Sum);
+            *Dest++ =
+                (RoundReal32ToUint32(Texel.a) << 24) |
+                (RoundReal32ToUint32(Texel.r) << 16) |
+                (RoundReal32ToUint32(Texel.g) << 8) |
+                (RoundReal32ToUint32(Texel.b) << 0);
+        }
+    }
+}
+
+/// Fills in every level after the first from the one before it
+internal void BuildMipChain(uint32* Texels, uint32 Width, uint32 Height, uint32 MipCount) {
+    uint32* Source = Texels;
+    for (uint32 Level = 1; Level < MipCount; ++Level) {
+        uint32* Dest = Source + (Width >> (Level - 1)) * (Height >> (Level - 1));
+        DownsampleMip(Source, Width >> (Level - 1), Height >> (Level - 1), Dest);
+        Source = Dest;
+    }
+}
+
+/// Converts a chain from rows to 4x4 blocks in place. The row-major chain has to sit at the very
+/// end of the memory for the tiled one (GetMipChainTexelCount with Tiled), a tiled level is never
+/// smaller than its rows so the blocks we write never catch up with the rows we haven't read yet.
+/// Scratch holds TEXEL_BLOCK_SIDE rows of the full size level, the rows of a block row get copied
+/// out there before the blocks overwrite them. Padding texels repeat the last row/column.
+internal void TileMipChain(uint32* Texels, uint32 Width, uint32 Height, uint32 MipCount, uint32* Scratch) {
+    uint32* Source = Texels +
+        GetMipChainTexelCount(Width, Height, MipCount, true) - GetMipChainTexelCount(Width, Height, MipCount);
+    uint32* Dest = Texels;
+    for (uint32 Level = 0; Level < MipCount; ++Level) {
+        uint32 LevelWidth = Width >> Level;
+        uint32 LevelHeight = Height >> Level;
+        for (uint32 BlockY = 0; BlockY * TEXEL_BLOCK_SIDE < LevelHeight; ++BlockY) {
+            for (uint32 RowIndex = 0; RowIndex < TEXEL_BLOCK_SIDE; ++RowIndex) {
+                uint32 Y = Minimum(BlockY * TEXEL_BLOCK_SIDE + RowIndex, LevelHeight - 1);
+                uint32* SourceRow = Source + Y * LevelWidth;
+                uint32* ScratchRow = Scratch + RowIndex * LevelWidth;
+                for (uint32 X = 0; X < LevelWidth; ++X) {
+                    ScratchRow[X] = SourceRow[X];
+                }
+            }
+            for (uint32 BlockX = 0; BlockX * TEXEL_BLOCK_SIDE < LevelWidth; ++BlockX) {
+                for (uint32 RowIndex = 0; RowIndex < TEXEL_BLOCK_SIDE; ++RowIndex) {
+                    for (uint32 ColumnIndex = 0; ColumnIndex < TEXEL_BLOCK_SIDE; ++ColumnIndex) {
+                        uint32 X = Minimum(BlockX * TEXEL_BLOCK_SIDE + ColumnIndex, LevelWidth - 1);
+                        *Dest++ = Scratch[RowIndex * LevelWidth + X];
+                    }
+                }
+            }
+        }
+        Source += LevelWidth * LevelHeight;
+    }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "math.cpp"
 #include "bmp.cpp"
 #include "asset.cpp"
+#include "mip.cpp"
 #include "../intrinsics.h"
 
 struct render_basis {
@@ -62,6 +63,11 @@ struct render_transform {
     real32 Scale;
 };
 
+enum render_pipeline {
+    RenderPipeline_Float,
+    RenderPipeline_FixedPoint,
+};
+
 struct render_group {
     game_assets* Assets;
     real32 GlobalAlpha;
@@ -72,10 +78,15 @@ struct render_group {
     uint32 PushBufferSize;
     uint8* PushBufferBase;
     uint32 MissingResourceCount;
+    // NOTE(sen) Entries dropped since BeginRender for landing off screen or behind the camera
+    uint32 CulledEntryCount;
     bool32 RendersInBackground;
     bool32 InsideRender;
+    render_pipeline Pipeline;
 };
 
+internal void InitSRGBTables();
+
 internal render_group*
 AllocateRenderGroup(game_assets* Assets, memory_arena* Arena, uint32 MaxPushBufferSize, bool32 RendersInBackground) {
     render_group* Result = PushStruct(Arena, render_group);
@@ -91,8 +102,11 @@ AllocateRenderGroup(game_assets* Assets, memory_arena* Arena, uint32 MaxPushBuff
     Result->Transform.OffsetP = V3(0, 0, 0);
     Result->Transform.Scale = 1.0f;
     Result->MissingResourceCount = 0;
+    Result->CulledEntryCount = 0;
     Result->RendersInBackground = RendersInBackground;
     Result->InsideRender = false;
+    Result->Pipeline = RenderPipeline_Float;
+    InitSRGBTables();
     return Result;
 }
 
@@ -102,6 +116,7 @@ BeginRender(render_group* Group) {
         Assert(!Group->InsideRender);
         Group->InsideRender = true;
         Group->GenerationID = BeginGeneration(Group->Assets);
+        Group->CulledEntryCount = 0;
     }
 }
 
@@ -116,6 +131,11 @@ EndRender(render_group* Group) {
     }
 }
 
+/// The fixed point pipeline trades some precision in the darks for integer-only blending
+internal void SetRenderPipeline(render_group* Group, render_pipeline Pipeline) {
+    Group->Pipeline = Pipeline;
+}
+
 internal inline void Perspective(
     render_group* Group, int32 PixelWidth, int32 PixelHeight,
     real32 MetersToPixels, real32 FocalLength, real32 DistanceAboveTarget
@@ -193,22 +213,53 @@ PushRenderElement_(render_group* Group, uint32 Size, render_group_entry_type Typ
     return Result;
 }
 
+/// Whether a projected quad (in pixels) could touch the screen, with a pixel of slack for the
+/// rasterizer's rounding
+internal bool32 IsOnScreen(render_group* Group, v2 P, v2 Dim) {
+    v2 ScreenDim = 2.0f * Group->Transform.ScreenCenter;
+    real32 MinX = Minimum(P.x, P.x + Dim.x);
+    real32 MaxX = Maximum(P.x, P.x + Dim.x);
+    real32 MinY = Minimum(P.y, P.y + Dim.y);
+    real32 MaxY = Maximum(P.y, P.y + Dim.y);
+    bool32 Result = MaxX >= -1.0f && MinX <= ScreenDim.x + 1.0f && MaxY >= -1.0f && MinY <= ScreenDim.y + 1.0f;
+    return Result;
+}
+
+struct used_bitmap_dim {
+    entity_basis_p_result Basis;
+    v2 Size;
+};
+
+internal used_bitmap_dim
+GetBitmapDim(render_group* Group, real32 WidthOverHeight, v2 AlignPercentage, real32 Height, v3 Offset) {
+    used_bitmap_dim Result;
+    Result.Size = V2(Height * WidthOverHeight, Height);
+    v2 Align = Hadamard(AlignPercentage, Result.Size);
+    v3 P = Offset - V3(Align, 0);
+    Result.Basis = GetRenderEntityBasisP(&Group->Transform, P);
+    return Result;
+}
+
+internal bool32 IsOnScreen(render_group* Group, used_bitmap_dim Dim) {
+    bool32 Result = Dim.Basis.Valid && IsOnScreen(Group, Dim.Basis.P, Dim.Basis.Scale * Dim.Size);
+    return Result;
+}
+
 internal inline void PushBitmap(
     render_group* Group, loaded_bitmap* Bitmap, real32 Height,
     v3 Offset, v4 Color = V4(1, 1, 1, 1)
 ) {
-    v2 Size = V2(Height * Bitmap->WidthOverHeight, Height);
-    v2 Align = Hadamard(Bitmap->AlignPercentage, Size);
-    v3 P = Offset - V3(Align, 0);
-    entity_basis_p_result Basis = GetRenderEntityBasisP(&Group->Transform, P);
-    if (Basis.Valid) {
+    used_bitmap_dim Dim = GetBitmapDim(Group, Bitmap->WidthOverHeight, Bitmap->AlignPercentage, Height, Offset);
+    if (IsOnScreen(Group, Dim)) {
         render_entry_bitmap* Entry = PushRenderElement(Group, render_entry_bitmap);
         if (Entry) {
             Entry->Bitmap = Bitmap;
-            Entry->P = Basis.P;
+            Entry->P = Dim.Basis.P;
             Entry->Color = Color * Group->GlobalAlpha;
-            Entry->Size = Basis.Scale * Size;
+            Entry->Size = Dim.Basis.Scale * Dim.Size;
         }
+    } else {
+        ++Group->CulledEntryCount;
     }
 }
 
@@ -217,6 +268,17 @@ internal inline void PushBitmap(
     render_group* Group, bitmap_id ID, real32 Height,
     v3 Offset, v4 Color = V4(1, 1, 1, 1)
 ) {
+    // NOTE(sen) Decide from the asset info so nothing gets loaded for sprites we won't draw
+    hha_bitmap* Info = GetBitmapInfo(Group->Assets, ID);
+    if (ID.Value && Info->Dim[1]) {
+        real32 WidthOverHeight = (real32)Info->Dim[0] / (real32)Info->Dim[1];
+        v2 AlignPercentage = V2(Info->AlignPercentage[0], Info->AlignPercentage[1]);
+        if (!IsOnScreen(Group, GetBitmapDim(Group, WidthOverHeight, AlignPercentage, Height, Offset))) {
+            ++Group->CulledEntryCount;
+            return;
+        }
+    }
+
     loaded_bitmap* Bitmap = GetBitmap(Group->Assets, ID, Group->GenerationID);
     if (Group->RendersInBackground && !Bitmap) {
         LoadBitmap(Group->Assets, ID, true);
@@ -250,13 +312,15 @@ internal inline void PushRect(
 ) {
     v3 P = Offset - V3(0.5f * Dim, 0);
     entity_basis_p_result Basis = GetRenderEntityBasisP(&Group->Transform, P);
-    if (Basis.Valid) {
+    if (Basis.Valid && IsOnScreen(Group, Basis.P, Basis.Scale * Dim)) {
         render_entry_rectangle* Rect = PushRenderElement(Group, render_entry_rectangle);
         if (Rect) {
             Rect->P = Basis.P;
             Rect->Color = Color;
             Rect->Dim = Basis.Scale * Dim;
         }
+    } else {
+        ++Group->CulledEntryCount;
     }
 }
 
@@ -303,23 +367,18 @@ internal void CoordinateSystem(
     render_group* Group, v2 Origin, v2 XAxis, v2 YAxis, v4 Color, loaded_bitmap* Texture,
     loaded_bitmap* NormalMap, environment_map* Top, environment_map* Middle, environment_map* Bottom
 ) {
-#if 0
-    entity_basis_p_result Basis = GetRenderEntityBasisP(RenderGroup, &Entry->EntityBasis, ScreenDim);
-    if (Basis.IsValid) {
-        render_entry_coordinate_system* Entry = PushRenderElement(Group, render_entry_coordinate_system);
-        if (Entry) {
-            Entry->Origin = Origin;
-            Entry->XAxis = XAxis;
-            Entry->YAxis = YAxis;
-            Entry->Color = Color;
-            Entry->Texture = Texture;
-            Entry->NormalMap = NormalMap;
-            Entry->Top = Top;
-            Entry->Middle = Middle;
-            Entry->Bottom = Bottom;
-        }
+    render_entry_coordinate_system* Entry = PushRenderElement(Group, render_entry_coordinate_system);
+    if (Entry) {
+        Entry->Origin = Origin;
+        Entry->XAxis = XAxis;
+        Entry->YAxis = YAxis;
+        Entry->Color = Color;
+        Entry->Texture = Texture;
+        Entry->NormalMap = NormalMap;
+        Entry->Top = Top;
+        Entry->Middle = Middle;
+        Entry->Bottom = Bottom;
     }
-#endif
 }
 
 internal v2 Unproject(render_group* Group, v2 ProjectedXY, real32 DistanceFromCamera) {
@@ -342,12 +401,116 @@ GetCameraRectagleAtTarget(render_group* Group) {
 }
 
 /// Maximums are not inclusive
-internal void DrawRectangle(
-    loaded_bitmap* Buffer,
-    v2 vMin, v2 vMax,
-    v4 Color,
-    rectangle2i ClipRect, bool32 Even
-) {
+internal uint32 PackColor32(v4 Color) {
+    uint32 Color32 =
+        (RoundReal32ToUint32(Color.a * 255.0f) << 24) |
+        (RoundReal32ToUint32(Color.r * 255.0f) << 16) |
+        (RoundReal32ToUint32(Color.g * 255.0f) << 8) |
+        (RoundReal32ToUint32(Color.b * 255.0f));
+    return Color32;
+}
+
+// NOTE(sen) Fills bigger than this are streamed past the cache, smaller ones (like a tile's clear)
+// are about to be drawn over and are better off staying in it
+#define STREAMING_FILL_MIN_BYTES Kilobytes(256)
+
+/// FillRect is already clipped and has the Even/Odd start row
+internal void FillRectangleSolid(loaded_bitmap* Buffer, rectangle2i FillRect, uint32 Color32, bool32 Stream) {
+    TIMED_FUNCTION();
+
+    __m128i Color_4x = _mm_set1_epi32(Color32);
+    uint8* Row = (uint8*)Buffer->Memory + FillRect.MinY * Buffer->Pitch;
+    for (int32 Y = FillRect.MinY; Y < FillRect.MaxY; Y += 2) {
+        uint32* Pixel = (uint32*)Row + FillRect.MinX;
+        uint32* OnePastLastPixel = (uint32*)Row + FillRect.MaxX;
+        while (Pixel < OnePastLastPixel && ((uintptr)Pixel & 15)) {
+            *Pixel++ = Color32;
+        }
+        if (Stream) {
+            for (; Pixel + 4 <= OnePastLastPixel; Pixel += 4) {
+                _mm_stream_si128((__m128i*)Pixel, Color_4x);
+            }
+        } else {
+            for (; Pixel + 8 <= OnePastLastPixel; Pixel += 8) {
+                _mm_store_si128((__m128i*)Pixel, Color_4x);
+                _mm_store_si128((__m128i*)Pixel + 1, Color_4x);
+            }
+            for (; Pixel + 4 <= OnePastLastPixel; Pixel += 4) {
+                _mm_store_si128((__m128i*)Pixel, Color_4x);
+            }
+        }
+        while (Pixel < OnePastLastPixel) {
+            *Pixel++ = Color32;
+        }
+        Row += 2 * Buffer->Pitch;
+    }
+    if (Stream) {
+        // NOTE(sen) Streaming stores aren't ordered with normal ones, make them visible before we're done
+        _mm_sfence();
+    }
+}
+
+/// Premultiplied blend in squared (roughly linear) space, same as DrawRectangleQuickly with a white texel
+internal void FillRectangleBlended(loaded_bitmap* Buffer, rectangle2i FillRect, v4 Color) {
+    TIMED_FUNCTION();
+
+    __m128i ClipMinX_4x = _mm_set1_epi32(FillRect.MinX - 1);
+    __m128i ClipMaxX_4x = _mm_set1_epi32(FillRect.MaxX);
+    int32 MinX = FillRect.MinX & ~3;
+    int32 MaxX = (FillRect.MaxX + 3) & ~3;
+
+    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
+    __m128i Four_4x = _mm_set1_epi32(4);
+    __m128 Sourcer_4x = _mm_set1_ps(Square(255.0f * Color.r) * Color.a);
+    __m128 Sourceg_4x = _mm_set1_ps(Square(255.0f * Color.g) * Color.a);
+    __m128 Sourceb_4x = _mm_set1_ps(Square(255.0f * Color.b) * Color.a);
+    __m128 Sourcea_4x = _mm_set1_ps(255.0f * Color.a);
+    __m128 InvSourceA_4x = _mm_set1_ps(1.0f - Color.a);
+
+    uint8* Row = (uint8*)Buffer->Memory + FillRect.MinY * Buffer->Pitch + MinX * BITMAP_BYTES_PER_PIXEL;
+    for (int32 Y = FillRect.MinY; Y < FillRect.MaxY; Y += 2) {
+        uint32* Pixel = (uint32*)Row;
+        __m128i PixelX = _mm_setr_epi32(MinX, MinX + 1, MinX + 2, MinX + 3);
+        for (int32 XI = MinX; XI < MaxX; XI += 4) {
+            __m128i WriteMask = _mm_and_si128(
+                _mm_cmpgt_epi32(PixelX, ClipMinX_4x),
+                _mm_cmpgt_epi32(ClipMaxX_4x, PixelX)
+            );
+
+            __m128i OriginalDest = _mm_load_si128((__m128i*)Pixel);
+            __m128 Destr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 16), MaskFF_4x));
+            __m128 Destg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 8), MaskFF_4x));
+            __m128 Destb = _mm_cvtepi32_ps(_mm_and_si128(OriginalDest, MaskFF_4x));
+            __m128 Desta = _mm_cvtepi32_ps(_mm_srli_epi32(OriginalDest, 24));
+
+            __m128 Blendedr = _mm_add_ps(_mm_mul_ps(InvSourceA_4x, _mm_mul_ps(Destr, Destr)), Sourcer_4x);
+            __m128 Blendedg = _mm_add_ps(_mm_mul_ps(InvSourceA_4x, _mm_mul_ps(Destg, Destg)), Sourceg_4x);
+            __m128 Blendedb = _mm_add_ps(_mm_mul_ps(InvSourceA_4x, _mm_mul_ps(Destb, Destb)), Sourceb_4x);
+            __m128 Blendeda = _mm_add_ps(_mm_mul_ps(InvSourceA_4x, Desta), Sourcea_4x);
+
+            // NOTE(sen) Real sqrt rather than rsqrt, a zero channel has to stay zero
+            Blendedr = _mm_sqrt_ps(Blendedr);
+            Blendedg = _mm_sqrt_ps(Blendedg);
+            Blendedb = _mm_sqrt_ps(Blendedb);
+
+            __m128i Out = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(_mm_cvtps_epi32(Blendedr), 16), _mm_slli_epi32(_mm_cvtps_epi32(Blendedg), 8)),
+                _mm_or_si128(_mm_cvtps_epi32(Blendedb), _mm_slli_epi32(_mm_cvtps_epi32(Blendeda), 24))
+            );
+            __m128i MaskedOut = _mm_or_si128(
+                _mm_and_si128(WriteMask, Out),
+                _mm_andnot_si128(WriteMask, OriginalDest)
+            );
+            _mm_store_si128((__m128i*)Pixel, MaskedOut);
+
+            Pixel += 4;
+            PixelX = _mm_add_epi32(PixelX, Four_4x);
+        }
+        Row += 2 * Buffer->Pitch;
+    }
+}
+
+internal rectangle2i GetFillRect(v2 vMin, v2 vMax, rectangle2i ClipRect, bool32 Even) {
     rectangle2i FillRect;
     FillRect.MinX = RoundReal32ToInt32(vMin.x);
     FillRect.MinY = RoundReal32ToInt32(vMin.y);
@@ -358,21 +521,35 @@ internal void DrawRectangle(
     if (!Even == (FillRect.MinY & 1)) {
         FillRect.MinY += 1;
     }
+    return FillRect;
+}
 
-    uint32 Color32 =
-        (RoundReal32ToUint32(Color.a * 255.0f) << 24) |
-        (RoundReal32ToUint32(Color.r * 255.0f) << 16) |
-        (RoundReal32ToUint32(Color.g * 255.0f) << 8) |
-        (RoundReal32ToUint32(Color.b * 255.0f));
+/// Opaque rectangles are a straight fill, translucent ones blend over what's there
+internal void DrawRectangle(
+    loaded_bitmap* Buffer,
+    v2 vMin, v2 vMax,
+    v4 Color,
+    rectangle2i ClipRect, bool32 Even
+) {
+    rectangle2i FillRect = GetFillRect(vMin, vMax, ClipRect, Even);
+    if (!HasArea(FillRect) || Color.a <= 0.0f) {
+        return;
+    }
+    if (Color.a >= 1.0f) {
+        FillRectangleSolid(Buffer, FillRect, PackColor32(Color), false);
+    } else {
+        FillRectangleBlended(Buffer, FillRect, Color);
+    }
+}
 
-    uint8* Row = (uint8*)Buffer->Memory + FillRect.MinY * Buffer->Pitch + FillRect.MinX * BITMAP_BYTES_PER_PIXEL;
-    for (int32 Y = FillRect.MinY; Y < FillRect.MaxY; Y += 2) {
-        uint32* Pixel = (uint32*)Row;
-        for (int32 X = FillRect.MinX; X < FillRect.MaxX; ++X) {
-            *Pixel++ = Color32;
-        }
-        Row += 2 * Buffer->Pitch;
+/// Overwrites everything including alpha, whatever the clear color's alpha is
+internal void ClearRectangle(loaded_bitmap* Buffer, v4 Color, rectangle2i ClipRect, bool32 Even) {
+    rectangle2i FillRect = GetFillRect(V2(0, 0), V2i(Buffer->Width, Buffer->Height), ClipRect, Even);
+    if (!HasArea(FillRect)) {
+        return;
     }
+    bool32 Stream = (uint32)GetClampedRectArea(FillRect) / 2 * BITMAP_BYTES_PER_PIXEL >= STREAMING_FILL_MIN_BYTES;
+    FillRectangleSolid(Buffer, FillRect, PackColor32(Color), Stream);
 }
 
 internal v4 Unpack4x8(uint32 Packed) {
@@ -389,13 +566,27 @@ struct bilinear_sample {
     uint32 A, B, C, D;
 };
 
+/// Bytes from the start of the level to the texel. A tiled offset is a part that only depends on X
+/// plus a part that only depends on Y, the SIMD fetches below rely on that.
+internal inline uint32 GetTexelOffset(loaded_bitmap* Texture, int32 X, int32 Y) {
+    uint32 Result;
+    if (Texture->Tiled) {
+        Result =
+            (X >> 2) * 64 + (X & 3) * BITMAP_BYTES_PER_PIXEL +
+            (Y >> 2) * Texture->Pitch + (Y & 3) * 16;
+    } else {
+        Result = Y * Texture->Pitch + X * BITMAP_BYTES_PER_PIXEL;
+    }
+    return Result;
+}
+
 internal bilinear_sample BilinearSample(loaded_bitmap* Texture, int32 X, int32 Y) {
-    uint8* TexelPtr = (uint8*)Texture->Memory + Y * Texture->Pitch + X * BITMAP_BYTES_PER_PIXEL;
+    uint8* Memory = (uint8*)Texture->Memory;
     bilinear_sample Result;
-    Result.A = *(uint32*)TexelPtr;
-    Result.B = *(uint32*)(TexelPtr + BITMAP_BYTES_PER_PIXEL);
-    Result.C = *(uint32*)(TexelPtr + Texture->Pitch);
-    Result.D = *(uint32*)(TexelPtr + Texture->Pitch + BITMAP_BYTES_PER_PIXEL);
+    Result.A = *(uint32*)(Memory + GetTexelOffset(Texture, X, Y));
+    Result.B = *(uint32*)(Memory + GetTexelOffset(Texture, X + 1, Y));
+    Result.C = *(uint32*)(Memory + GetTexelOffset(Texture, X, Y + 1));
+    Result.D = *(uint32*)(Memory + GetTexelOffset(Texture, X + 1, Y + 1));
     return Result;
 }
 
@@ -465,7 +656,6 @@ internal v4 UnscaleAndBiasNormal(v4 Normal) {
     Result.w = Inv255 * Normal.w;
     return Result;
 }
-unsigned long long __rdtsc();
 internal void DrawRectangleSlowly(
     loaded_bitmap* Buffer,
     v2 Origin, v2 XAxis, v2 YAxis,
@@ -685,14 +875,262 @@ internal void DrawRectangleSlowly(
     //END_TIMED_BLOCK(DrawRectangleSlowly);
 }
 
-#if 1
+#if COMPILER_MSVC
 #include "../../iacaMarks.h"
 #else
 #define IACA_VC64_START
 #define IACA_VC64_END
 #endif
 
-internal void DrawRectangleQuickly(
+#if COMPILER_MSVC
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+// NOTE(sen) For scalar helpers the rasterizers call once a row. Calling out of the AVX2 one spills
+// every ymm register it holds, which costs more than the helper saves on small sprites
+#if COMPILER_MSVC
+#define FORCE_INLINE __forceinline
+#else
+#define FORCE_INLINE __attribute__((always_inline)) inline
+#endif
+
+enum rasterizer_simd {
+    RasterizerSIMD_Unknown,
+    RasterizerSIMD_SSE2,
+    RasterizerSIMD_AVX2,
+};
+
+// NOTE(sen) Worked out on first use, every thread gets the same answer so racing on it is fine
+global_variable rasterizer_simd volatile GlobalRasterizerSIMD;
+
+internal inline rasterizer_simd GetRasterizerSIMD() {
+    rasterizer_simd Result = GlobalRasterizerSIMD;
+    if (Result == RasterizerSIMD_Unknown) {
+#if 1
+        Result = CPUSupportsAVX2() ? RasterizerSIMD_AVX2 : RasterizerSIMD_SSE2;
+#else
+        Result = RasterizerSIMD_SSE2;
+#endif
+        GlobalRasterizerSIMD = Result;
+    }
+    return Result;
+}
+
+// NOTE(sen) Offsets for the bilinear taps of tiled textures (see GetTexelOffset). The X part of
+// the offset for X and X + 1 plus the Y part for Y and Y + 1 gives all four.
+internal inline __m128i TiledTexelColumnOffset(__m128i X) {
+    __m128i Three = _mm_set1_epi32(3);
+    __m128i Result = _mm_add_epi32(
+        _mm_slli_epi32(_mm_andnot_si128(Three, X), 4),
+        _mm_slli_epi32(_mm_and_si128(X, Three), 2)
+    );
+    return Result;
+}
+
+internal inline __m128i TiledTexelRowOffset(__m128i Y, __m128i BlocksPerRow) {
+    __m128i BlockY = _mm_srli_epi32(Y, 2);
+    // NOTE(sen) Both under 2^15 so the 16-bit multiply has the whole product
+    __m128i BlockIndex = _mm_or_si128(
+        _mm_mullo_epi16(BlockY, BlocksPerRow),
+        _mm_slli_epi32(_mm_mulhi_epi16(BlockY, BlocksPerRow), 16)
+    );
+    __m128i Result = _mm_add_epi32(
+        _mm_slli_epi32(BlockIndex, 6),
+        _mm_slli_epi32(_mm_and_si128(Y, _mm_set1_epi32(3)), 4)
+    );
+    return Result;
+}
+
+TARGET_AVX2 internal inline __m256i TiledTexelColumnOffset(__m256i X) {
+    __m256i Three = _mm256_set1_epi32(3);
+    __m256i Result = _mm256_add_epi32(
+        _mm256_slli_epi32(_mm256_andnot_si256(Three, X), 4),
+        _mm256_slli_epi32(_mm256_and_si256(X, Three), 2)
+    );
+    return Result;
+}
+
+TARGET_AVX2 internal inline __m256i TiledTexelRowOffset(__m256i Y, __m256i Pitch) {
+    __m256i Result = _mm256_add_epi32(
+        _mm256_mullo_epi32(_mm256_srli_epi32(Y, 2), Pitch),
+        _mm256_slli_epi32(_mm256_and_si256(Y, _mm256_set1_epi32(3)), 4)
+    );
+    return Result;
+}
+
+/// Pixels a quad can touch, same rounding as the FillRect in DrawRectangleQuickly
+internal rectangle2i GetQuadScreenBounds(v2 Origin, v2 XAxis, v2 YAxis) {
+    v2 P[4] = {
+        Origin,
+        Origin + XAxis,
+        Origin + XAxis + YAxis,
+        Origin + YAxis
+    };
+    real32 MinX = P[0].x;
+    real32 MaxX = P[0].x;
+    real32 MinY = P[0].y;
+    real32 MaxY = P[0].y;
+    for (uint32 PIndex = 1; PIndex < ArrayCount(P); PIndex++) {
+        MinX = Minimum(MinX, P[PIndex].x);
+        MaxX = Maximum(MaxX, P[PIndex].x);
+        MinY = Minimum(MinY, P[PIndex].y);
+        MaxY = Maximum(MaxY, P[PIndex].y);
+    }
+    rectangle2i Result;
+    Result.MinX = FloorReal32ToInt32(MinX);
+    Result.MaxX = CeilReal32ToInt32(MaxX) + 1;
+    Result.MinY = FloorReal32ToInt32(MinY);
+    Result.MaxY = CeilReal32ToInt32(MaxY) + 1;
+    return Result;
+}
+
+/// Screen bounds of the part of a quad that can pick up texels that aren't transparent (see
+/// hha_bitmap_coverage). Texture is the level we sample, the trim rect is for the full size one.
+internal rectangle2i GetCoveredQuadScreenBounds(loaded_bitmap* Texture, v2 Origin, v2 XAxis, v2 YAxis) {
+    rectangle2i Result = GetQuadScreenBounds(Origin, XAxis, YAxis);
+    hha_bitmap_coverage* Coverage = Texture->Coverage;
+    if (Coverage && Texture->Width > 2 && Texture->Height > 2) {
+        if (Coverage->TrimMax[0] == 0) {
+            Result = {};
+        } else {
+            uint32 Level = Texture->MipLevel;
+            uint32 LevelRound = (1 << Level) - 1;
+            real32 MinX = (real32)(Coverage->TrimMin[0] >> Level);
+            real32 MinY = (real32)(Coverage->TrimMin[1] >> Level);
+            real32 MaxX = (real32)((Coverage->TrimMax[0] + LevelRound) >> Level);
+            real32 MaxY = (real32)((Coverage->TrimMax[1] + LevelRound) >> Level);
+            // NOTE(sen) A pixel picks up texel X when its texture coordinate is in [X - 1, X + 1), that
+            // less the 0.5 the rasterizers add, plus half a texel of slack either side for rounding
+            real32 MinU = Clamp01((MinX - 2.0f) / (real32)(Texture->Width - 2));
+            real32 MinV = Clamp01((MinY - 2.0f) / (real32)(Texture->Height - 2));
+            real32 MaxU = Clamp01(MaxX / (real32)(Texture->Width - 2));
+            real32 MaxV = Clamp01(MaxY / (real32)(Texture->Height - 2));
+            Result = GetQuadScreenBounds(
+                Origin + MinU * XAxis + MinV * YAxis, (MaxU - MinU) * XAxis, (MaxV - MinV) * YAxis
+            );
+        }
+    }
+    return Result;
+}
+
+struct covered_row_span {
+    int32 MinX;
+    int32 MaxX;
+    int32 OpaqueMinX;
+    int32 OpaqueMaxX;
+};
+
+/// Whether GetCoveredRowSpan can be used, the quad can't be rotated
+internal bool32 HasCoveredRowSpans(loaded_bitmap* Texture, v2 XAxis, v2 YAxis) {
+    bool32 Result =
+        Texture->Coverage && Texture->Width > 2 && Texture->Height > 2 &&
+        XAxis.y == 0 && YAxis.x == 0 && XAxis.x != 0 && YAxis.y != 0;
+    return Result;
+}
+
+/// Pixels on screen row Y that can pick up texels that aren't transparent, and the ones where
+/// all four bilinear taps have full alpha (OpaqueMaxX <= OpaqueMinX if there are none). Both
+/// are conservative, the rasterizers round them out to whole 4-pixel groups anyway.
+FORCE_INLINE internal covered_row_span GetCoveredRowSpan(loaded_bitmap* Texture, v2 Origin, v2 XAxis, v2 YAxis, int32 Y) {
+    uint32 Level = Texture->MipLevel;
+    int32 FullHeight = Texture->Height << Level;
+    hha_bitmap_row_span* RowSpans = (hha_bitmap_row_span*)(Texture->Coverage + 1);
+
+    real32 V = Clamp01(((real32)Y - Origin.y) / YAxis.y);
+    int32 TexelY = FloorReal32ToInt32(V * (real32)(Texture->Height - 2) + 0.5f);
+
+    // NOTE(sen) The taps are rows TexelY and TexelY + 1, one more either side for rounding
+    int32 FirstRow = Maximum(TexelY - 1, 0) << Level;
+    int32 OnePastLastRow = Minimum((TexelY + 3) << Level, FullHeight);
+    int32 MinX = INT32_MAX;
+    int32 MaxX = 0;
+    int32 OpaqueMinX = 0;
+    int32 OpaqueMaxX = INT32_MAX;
+    for (int32 RowIndex = FirstRow; RowIndex < OnePastLastRow; ++RowIndex) {
+        hha_bitmap_row_span* Span = RowSpans + RowIndex;
+        if (Span->MaxX) {
+            MinX = Minimum(MinX, (int32)Span->MinX);
+            MaxX = Maximum(MaxX, (int32)Span->MaxX);
+        }
+        OpaqueMinX = Maximum(OpaqueMinX, (int32)Span->OpaqueMinX);
+        OpaqueMaxX = Minimum(OpaqueMaxX, (int32)Span->OpaqueMaxX);
+    }
+
+    // NOTE(sen) A texel of a smaller level is covered if any of the ones it came from are, opaque
+    // only if all of them are
+    int32 LevelRound = (1 << Level) - 1;
+    real32 CoveredMinTexel = (real32)(MinX >> Level);
+    real32 CoveredMaxTexel = (real32)((MaxX + LevelRound) >> Level);
+    real32 OpaqueMinTexel = (real32)((OpaqueMinX + LevelRound) >> Level);
+    real32 OpaqueMaxTexel = (real32)(OpaqueMaxX >> Level);
+
+    // NOTE(sen) Back from texture coordinates to screen ones, see GetCoveredQuadScreenBounds for the offsets
+    real32 TexelsToPixels = XAxis.x / (real32)(Texture->Width - 2);
+    real32 CoveredA = Origin.x + (CoveredMinTexel - 2.0f) * TexelsToPixels;
+    real32 CoveredB = Origin.x + CoveredMaxTexel * TexelsToPixels;
+    real32 OpaqueA = Origin.x + (OpaqueMinTexel + 0.5f) * TexelsToPixels;
+    real32 OpaqueB = Origin.x + (OpaqueMaxTexel - 2.0f) * TexelsToPixels;
+
+    covered_row_span Result;
+    if (MaxX == 0) {
+        Result.MinX = 0;
+        Result.MaxX = 0;
+    } else {
+        Result.MinX = FloorReal32ToInt32(Minimum(CoveredA, CoveredB)) - 1;
+        Result.MaxX = CeilReal32ToInt32(Maximum(CoveredA, CoveredB)) + 1;
+    }
+    if (OpaqueMaxTexel - OpaqueMinTexel < 2.0f) {
+        Result.OpaqueMinX = 0;
+        Result.OpaqueMaxX = 0;
+    } else {
+        Result.OpaqueMinX = CeilReal32ToInt32(Minimum(OpaqueA, OpaqueB)) + 1;
+        Result.OpaqueMaxX = FloorReal32ToInt32(Maximum(OpaqueA, OpaqueB)) - 1;
+    }
+    return Result;
+}
+
+struct quad_row_span {
+    int32 MinX;
+    int32 MaxX;
+};
+
+/// Narrows [Min, Max] down to the X where 0 <= (X - OriginX) * Slope + Offset <= 1
+FORCE_INLINE internal void ClipToUnitRange(real32 OriginX, real32 Slope, real32 Offset, real32* Min, real32* Max) {
+    if (Slope > 0) {
+        *Min = Maximum(*Min, OriginX - Offset / Slope);
+        *Max = Minimum(*Max, OriginX + (1.0f - Offset) / Slope);
+    } else if (Slope < 0) {
+        *Min = Maximum(*Min, OriginX + (1.0f - Offset) / Slope);
+        *Max = Minimum(*Max, OriginX - Offset / Slope);
+    } else if (Offset < 0 || Offset > 1) {
+        *Max = *Min - 1;
+    }
+}
+
+/// Pixels on screen row Y inside the quad, from where the row crosses the U = 0, U = 1, V = 0 and
+/// V = 1 edges. A pixel wider either side than it has to be, the kernels' own U/V test still
+/// decides the edge pixels, so this only ever saves work and never changes what gets drawn.
+FORCE_INLINE internal quad_row_span GetQuadRowSpan(v2 Origin, v2 nXAxis, v2 nYAxis, int32 MinX, int32 MaxX, int32 Y) {
+    real32 Py = (real32)Y - Origin.y;
+    real32 Min = (real32)MinX;
+    real32 Max = (real32)MaxX;
+    ClipToUnitRange(Origin.x, nXAxis.x, Py * nXAxis.y, &Min, &Max);
+    ClipToUnitRange(Origin.x, nYAxis.x, Py * nYAxis.y, &Min, &Max);
+
+    quad_row_span Result = {};
+    if (Min <= Max) {
+        Result.MinX = FloorReal32ToInt32(Min) - 1;
+        Result.MaxX = CeilReal32ToInt32(Max) + 2;
+    }
+    return Result;
+}
+
+// NOTE(sen) Same as the SSE2 version below but 8 pixels at a time with FMA for the bilinear
+// blend. The span is still 4-aligned since tiles are, and a trailing 4 pixels only touch the
+// low half so we never write into a neighbouring tile.
+TARGET_AVX2 internal void DrawRectangleQuicklyAVX2(
     loaded_bitmap* Buffer,
     v2 Origin, v2 XAxis, v2 YAxis,
     v4 Color, loaded_bitmap* Texture,
@@ -703,16 +1141,6 @@ internal void DrawRectangleQuickly(
 
     Color.rgb *= Color.a;
 
-    real32 XAxisLength = Length(XAxis);
-    real32 YAxisLength = Length(YAxis);
-
-    v2 NxAxis = (YAxisLength / XAxisLength) * XAxis;
-    v2 NyAxis = (XAxisLength / YAxisLength) * YAxis;
-    real32 NzScale = 0.5f * (XAxisLength + YAxisLength);
-
-    int32 WidthMax = Buffer->Width - 3;
-    int32 HeightMax = Buffer->Height - 3;
-
     rectangle2i FillRect = InvertedInfinityRectangle();
 
     v2 P[4] = {
@@ -742,6 +1170,7 @@ internal void DrawRectangleQuickly(
     }
 
     FillRect = Intersect(FillRect, ClipRect);
+    FillRect = Intersect(FillRect, GetCoveredQuadScreenBounds(Texture, Origin, XAxis, YAxis));
 
     // NOTE(sen) Alternating scanlines
     if (!Even == (FillRect.MinY & 1)) {
@@ -752,28 +1181,10 @@ internal void DrawRectangleQuickly(
         return;
     }
 
-    __m128i StartClipMask = _mm_set1_epi32(-1);
-    __m128i EndClipMask = _mm_set1_epi32(-1);
-    __m128i StartClipMasks[4] = {
-        StartClipMask,
-        _mm_slli_si128(StartClipMask, 1 * 4),
-        _mm_slli_si128(StartClipMask, 2 * 4),
-        _mm_slli_si128(StartClipMask, 3 * 4)
-    };
-    __m128i EndClipMasks[4] = {
-        EndClipMask,
-        _mm_srli_si128(EndClipMask, 3 * 4),
-        _mm_srli_si128(EndClipMask, 2 * 4),
-        _mm_srli_si128(EndClipMask, 1 * 4)
-    };
-    if (FillRect.MinX & 3) {
-        StartClipMask = StartClipMasks[FillRect.MinX & 3];
-        FillRect.MinX = FillRect.MinX & ~3;
-    }
-    if (FillRect.MaxX & 3) {
-        EndClipMask = EndClipMasks[FillRect.MaxX & 3];
-        FillRect.MaxX = (FillRect.MaxX & ~3) + 4;
-    }
+    __m256i ClipMinX_8x = _mm256_set1_epi32(FillRect.MinX - 1);
+    __m256i ClipMaxX_8x = _mm256_set1_epi32(FillRect.MaxX);
+    FillRect.MinX = FillRect.MinX & ~3;
+    FillRect.MaxX = (FillRect.MaxX + 3) & ~3;
 
     real32 InvXAxisLengthSq = 1 / LengthSq(XAxis);
     real32 InvYAxisLengthSq = 1 / LengthSq(YAxis);
@@ -781,34 +1192,458 @@ internal void DrawRectangleQuickly(
     v2 nXAxis = XAxis * InvXAxisLengthSq;
     v2 nYAxis = YAxis * InvYAxisLengthSq;
 
-    __m128 One255_4x = _mm_set1_ps(255.0f);
-    __m128 Half_4x = _mm_set1_ps(0.5f);
-    real32 Inv255 = 1.0f / 255.0f;
-    __m128 Inv255_4x = _mm_set1_ps(Inv255);
-    __m128 One_4x = _mm_set1_ps(1.0f);
-    __m128 Two_4x = _mm_set1_ps(2.0f);
-    __m128 Zero_4x = _mm_set1_ps(0.0f);
-    __m128 Four_4x = _mm_set1_ps(4.0f);
-    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
-    __m128i MaskFFFF_4x = _mm_set1_epi32(0xFFFF);
-    __m128i MaskFF00FF_4x = _mm_set1_epi32(0x00FF00FF);
-    __m128i MaskFF00FF00_4x = _mm_set1_epi32(0xFF00FF00);
-    __m128 MaxColorValue_4x = _mm_set1_ps(255.0f * 255.0f);
+    __m256 Half_8x = _mm256_set1_ps(0.5f);
+    __m256 Inv255_8x = _mm256_set1_ps(1.0f / 255.0f);
+    __m256 One_8x = _mm256_set1_ps(1.0f);
+    __m256 Zero_8x = _mm256_set1_ps(0.0f);
+    __m256 Eight_8x = _mm256_set1_ps(8.0f);
+    __m256i MaskFF_8x = _mm256_set1_epi32(0xFF);
+    __m256i MaskFFFF_8x = _mm256_set1_epi32(0xFFFF);
+    __m256i MaskFF00FF_8x = _mm256_set1_epi32(0x00FF00FF);
+    __m256i MaskFF00FF00_8x = _mm256_set1_epi32(0xFF00FF00);
+    __m256 MaxColorValue_8x = _mm256_set1_ps(255.0f * 255.0f);
+    __m256i LaneOffsets_8x = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i Eighti_8x = _mm256_set1_epi32(8);
+
+    __m256 Colorr_8x = _mm256_set1_ps(Color.r);
+    __m256 Colorg_8x = _mm256_set1_ps(Color.g);
+    __m256 Colorb_8x = _mm256_set1_ps(Color.b);
+    __m256 Colora_8x = _mm256_set1_ps(Color.a);
+
+    __m256 nXAxisx_8x = _mm256_set1_ps(nXAxis.x);
+    __m256 nXAxisy_8x = _mm256_set1_ps(nXAxis.y);
+    __m256 nYAxisx_8x = _mm256_set1_ps(nYAxis.x);
+    __m256 nYAxisy_8x = _mm256_set1_ps(nYAxis.y);
+
+    __m256 Originx_8x = _mm256_set1_ps(Origin.x);
+    __m256 Originy_8x = _mm256_set1_ps(Origin.y);
+
+    __m256 WidthM2 = _mm256_set1_ps((real32)Texture->Width - 2);
+    __m256 HeightM2 = _mm256_set1_ps((real32)Texture->Height - 2);
 
-    real32 NormalizeC = 1 / 255.0f;
-    real32 NormalizeCSq = Square(NormalizeC);
-    __m128 Colorr_4x = _mm_set1_ps(Color.r);
-    __m128 Colorg_4x = _mm_set1_ps(Color.g);
-    __m128 Colorb_4x = _mm_set1_ps(Color.b);
-    __m128 Colora_4x = _mm_set1_ps(Color.a);
+    uint8* TextureMemory = (uint8*)Texture->Memory;
+    int32 TexturePitch = Texture->Pitch;
+    __m256i TexturePitch_8x = _mm256_set1_epi32(TexturePitch);
+    bool32 TextureTiled = Texture->Tiled;
+    __m256i One_8xi = _mm256_set1_epi32(1);
 
-    __m128 nXAxisx_4x = _mm_set1_ps(nXAxis.x);
-    __m128 nXAxisy_4x = _mm_set1_ps(nXAxis.y);
-    __m128 nYAxisx_4x = _mm_set1_ps(nYAxis.x);
-    __m128 nYAxisy_4x = _mm_set1_ps(nYAxis.y);
+    uint8* Row = (uint8*)Buffer->Memory + FillRect.MinY * Buffer->Pitch + FillRect.MinX * BITMAP_BYTES_PER_PIXEL;
+    int32 RowAdvance = Buffer->Pitch * 2;
 
-    __m128 Originx_4x = _mm_set1_ps(Origin.x);
-    __m128 Originy_4x = _mm_set1_ps(Origin.y);
+    int32 MaxY = FillRect.MaxY;
+    int32 MinY = FillRect.MinY;
+    int32 MaxX = FillRect.MaxX;
+    int32 MinX = FillRect.MinX;
+
+    bool32 UseRowSpans = HasCoveredRowSpans(Texture, XAxis, YAxis);
+    bool32 OpaqueColor = Color.a == 1.0f;
+
+    TIMED_BLOCK(PixelFill, GetClampedRectArea(FillRect) / 2);
+    for (int32 Y = MinY; Y < MaxY; Y += 2) {
+
+        quad_row_span QuadSpan = GetQuadRowSpan(Origin, nXAxis, nYAxis, MinX, MaxX, Y);
+        int32 RowMinX = Maximum(MinX, QuadSpan.MinX & ~3);
+        int32 RowMaxX = Minimum(MaxX, (QuadSpan.MaxX + 3) & ~3);
+        int32 OpaqueMinX = 0;
+        int32 OpaqueMaxX = 0;
+        if (UseRowSpans) {
+            covered_row_span Span = GetCoveredRowSpan(Texture, Origin, XAxis, YAxis, Y);
+            RowMinX = Maximum(RowMinX, Span.MinX & ~3);
+            RowMaxX = Minimum(RowMaxX, (Span.MaxX + 3) & ~3);
+            if (OpaqueColor) {
+                OpaqueMinX = Span.OpaqueMinX;
+                OpaqueMaxX = Span.OpaqueMaxX;
+            }
+        }
+
+        uint32* Pixel = (uint32*)Row + (RowMinX - MinX);
+        __m256 PixelPy = _mm256_sub_ps(_mm256_set1_ps((real32)Y), Originy_8x);
+        __m256 PynX = _mm256_mul_ps(PixelPy, nXAxisy_8x);
+        __m256 PynY = _mm256_mul_ps(PixelPy, nYAxisy_8x);
+
+        __m256i PixelX = _mm256_add_epi32(_mm256_set1_epi32(RowMinX), LaneOffsets_8x);
+        __m256 PixelPx = _mm256_sub_ps(_mm256_cvtepi32_ps(PixelX), Originx_8x);
+
+        for (int32 XI = RowMinX; XI < RowMaxX; XI += 8) {
+
+#define Mi8(a, i) (((uint32*)(&(a)))[i])
+#define mmGatherTexels8(Base, Offsets) _mm256_setr_epi32( \
+    *(uint32*)((Base) + Mi8(Offsets, 0)), *(uint32*)((Base) + Mi8(Offsets, 1)), \
+    *(uint32*)((Base) + Mi8(Offsets, 2)), *(uint32*)((Base) + Mi8(Offsets, 3)), \
+    *(uint32*)((Base) + Mi8(Offsets, 4)), *(uint32*)((Base) + Mi8(Offsets, 5)), \
+    *(uint32*)((Base) + Mi8(Offsets, 6)), *(uint32*)((Base) + Mi8(Offsets, 7)))
+
+            bool32 FullWidth = XI + 8 <= RowMaxX;
+
+            __m256 U = _mm256_fmadd_ps(PixelPx, nXAxisx_8x, PynX);
+            __m256 V = _mm256_fmadd_ps(PixelPx, nYAxisx_8x, PynY);
+
+            __m256i OriginalDest = FullWidth ?
+                _mm256_loadu_si256((__m256i*)Pixel) :
+                _mm256_inserti128_si256(_mm256_setzero_si256(), _mm_load_si128((__m128i*)Pixel), 0);
+
+            __m256i WriteMask = _mm256_castps_si256(_mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(U, Zero_8x, _CMP_GE_OQ), _mm256_cmp_ps(U, One_8x, _CMP_LE_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(V, Zero_8x, _CMP_GE_OQ), _mm256_cmp_ps(V, One_8x, _CMP_LE_OQ))
+            ));
+            __m256i ClipMask = _mm256_and_si256(
+                _mm256_cmpgt_epi32(PixelX, ClipMinX_8x),
+                _mm256_cmpgt_epi32(ClipMaxX_8x, PixelX)
+            );
+            WriteMask = _mm256_and_si256(WriteMask, ClipMask);
+
+            U = _mm256_min_ps(_mm256_max_ps(U, Zero_8x), One_8x);
+            V = _mm256_min_ps(_mm256_max_ps(V, Zero_8x), One_8x);
+
+            __m256 TextureX = _mm256_fmadd_ps(U, WidthM2, Half_8x);
+            __m256 TextureY = _mm256_fmadd_ps(V, HeightM2, Half_8x);
+
+            __m256i TextureXFloored = _mm256_cvttps_epi32(TextureX);
+            __m256i TextureYFloored = _mm256_cvttps_epi32(TextureY);
+
+            __m256 TextureXf = _mm256_sub_ps(TextureX, _mm256_cvtepi32_ps(TextureXFloored));
+            __m256 TextureYf = _mm256_sub_ps(TextureY, _mm256_cvtepi32_ps(TextureYFloored));
+
+            // NOTE(sen) Scalar loads rather than vpgatherdd, gathers are slow on AMD and on Intel
+            // parts with the gather data sampling microcode fix
+            __m256i SampleA, SampleB, SampleC, SampleD;
+            if (TextureTiled) {
+                __m256i ColumnA = TiledTexelColumnOffset(TextureXFloored);
+                __m256i ColumnB = TiledTexelColumnOffset(_mm256_add_epi32(TextureXFloored, One_8xi));
+                __m256i RowA = TiledTexelRowOffset(TextureYFloored, TexturePitch_8x);
+                __m256i RowC = TiledTexelRowOffset(_mm256_add_epi32(TextureYFloored, One_8xi), TexturePitch_8x);
+                __m256i FetchA = _mm256_add_epi32(ColumnA, RowA);
+                __m256i FetchB = _mm256_add_epi32(ColumnB, RowA);
+                __m256i FetchC = _mm256_add_epi32(ColumnA, RowC);
+                __m256i FetchD = _mm256_add_epi32(ColumnB, RowC);
+                SampleA = mmGatherTexels8(TextureMemory, FetchA);
+                SampleB = mmGatherTexels8(TextureMemory, FetchB);
+                SampleC = mmGatherTexels8(TextureMemory, FetchC);
+                SampleD = mmGatherTexels8(TextureMemory, FetchD);
+            } else {
+                __m256i Fetch_8x = _mm256_add_epi32(
+                    _mm256_slli_epi32(TextureXFloored, 2),
+                    _mm256_mullo_epi32(TextureYFloored, TexturePitch_8x)
+                );
+
+                uint8* TexelPtr0 = TextureMemory + Mi8(Fetch_8x, 0);
+                uint8* TexelPtr1 = TextureMemory + Mi8(Fetch_8x, 1);
+                uint8* TexelPtr2 = TextureMemory + Mi8(Fetch_8x, 2);
+                uint8* TexelPtr3 = TextureMemory + Mi8(Fetch_8x, 3);
+                uint8* TexelPtr4 = TextureMemory + Mi8(Fetch_8x, 4);
+                uint8* TexelPtr5 = TextureMemory + Mi8(Fetch_8x, 5);
+                uint8* TexelPtr6 = TextureMemory + Mi8(Fetch_8x, 6);
+                uint8* TexelPtr7 = TextureMemory + Mi8(Fetch_8x, 7);
+
+                SampleA = _mm256_setr_epi32(
+                    *(uint32*)TexelPtr0, *(uint32*)TexelPtr1, *(uint32*)TexelPtr2, *(uint32*)TexelPtr3,
+                    *(uint32*)TexelPtr4, *(uint32*)TexelPtr5, *(uint32*)TexelPtr6, *(uint32*)TexelPtr7
+                );
+                SampleB = _mm256_setr_epi32(
+                    *(uint32*)(TexelPtr0 + BITMAP_BYTES_PER_PIXEL), *(uint32*)(TexelPtr1 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr2 + BITMAP_BYTES_PER_PIXEL), *(uint32*)(TexelPtr3 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr4 + BITMAP_BYTES_PER_PIXEL), *(uint32*)(TexelPtr5 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr6 + BITMAP_BYTES_PER_PIXEL), *(uint32*)(TexelPtr7 + BITMAP_BYTES_PER_PIXEL)
+                );
+                SampleC = _mm256_setr_epi32(
+                    *(uint32*)(TexelPtr0 + TexturePitch), *(uint32*)(TexelPtr1 + TexturePitch),
+                    *(uint32*)(TexelPtr2 + TexturePitch), *(uint32*)(TexelPtr3 + TexturePitch),
+                    *(uint32*)(TexelPtr4 + TexturePitch), *(uint32*)(TexelPtr5 + TexturePitch),
+                    *(uint32*)(TexelPtr6 + TexturePitch), *(uint32*)(TexelPtr7 + TexturePitch)
+                );
+                SampleD = _mm256_setr_epi32(
+                    *(uint32*)(TexelPtr0 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr1 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr2 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr3 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr4 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr5 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr6 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr7 + TexturePitch + BITMAP_BYTES_PER_PIXEL)
+                );
+            }
+
+            __m256i TexelArb = _mm256_and_si256(SampleA, MaskFF00FF_8x);
+            __m256i TexelAag = _mm256_and_si256(SampleA, MaskFF00FF00_8x);
+            TexelArb = _mm256_mullo_epi16(TexelArb, TexelArb);
+            __m256 TexelAa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelAag, 24));
+            TexelAag = _mm256_mulhi_epu16(TexelAag, TexelAag);
+
+            __m256i TexelBrb = _mm256_and_si256(SampleB, MaskFF00FF_8x);
+            __m256i TexelBag = _mm256_and_si256(SampleB, MaskFF00FF00_8x);
+            TexelBrb = _mm256_mullo_epi16(TexelBrb, TexelBrb);
+            __m256 TexelBa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelBag, 24));
+            TexelBag = _mm256_mulhi_epu16(TexelBag, TexelBag);
+
+            __m256i TexelCrb = _mm256_and_si256(SampleC, MaskFF00FF_8x);
+            __m256i TexelCag = _mm256_and_si256(SampleC, MaskFF00FF00_8x);
+            TexelCrb = _mm256_mullo_epi16(TexelCrb, TexelCrb);
+            __m256 TexelCa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelCag, 24));
+            TexelCag = _mm256_mulhi_epu16(TexelCag, TexelCag);
+
+            __m256i TexelDrb = _mm256_and_si256(SampleD, MaskFF00FF_8x);
+            __m256i TexelDag = _mm256_and_si256(SampleD, MaskFF00FF00_8x);
+            TexelDrb = _mm256_mullo_epi16(TexelDrb, TexelDrb);
+            __m256 TexelDa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelDag, 24));
+            TexelDag = _mm256_mulhi_epu16(TexelDag, TexelDag);
+
+            __m256 TexelAr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelArb, 16));
+            __m256 TexelAg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelAag, MaskFFFF_8x));
+            __m256 TexelAb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelArb, MaskFFFF_8x));
+
+            __m256 TexelBr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelBrb, 16));
+            __m256 TexelBg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelBag, MaskFFFF_8x));
+            __m256 TexelBb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelBrb, MaskFFFF_8x));
+
+            __m256 TexelCr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelCrb, 16));
+            __m256 TexelCg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelCag, MaskFFFF_8x));
+            __m256 TexelCb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelCrb, MaskFFFF_8x));
+
+            __m256 TexelDr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelDrb, 16));
+            __m256 TexelDg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelDag, MaskFFFF_8x));
+            __m256 TexelDb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelDrb, MaskFFFF_8x));
+
+            __m256 ifx = _mm256_sub_ps(One_8x, TextureXf);
+            __m256 ify = _mm256_sub_ps(One_8x, TextureYf);
+
+            __m256 l0 = _mm256_mul_ps(ify, ifx);
+            __m256 l1 = _mm256_mul_ps(ify, TextureXf);
+            __m256 l2 = _mm256_mul_ps(TextureYf, ifx);
+            __m256 l3 = _mm256_mul_ps(TextureYf, TextureXf);
+
+            __m256 Texelr = _mm256_fmadd_ps(l0, TexelAr, _mm256_fmadd_ps(l1, TexelBr, _mm256_fmadd_ps(l2, TexelCr, _mm256_mul_ps(l3, TexelDr))));
+            __m256 Texelg = _mm256_fmadd_ps(l0, TexelAg, _mm256_fmadd_ps(l1, TexelBg, _mm256_fmadd_ps(l2, TexelCg, _mm256_mul_ps(l3, TexelDg))));
+            __m256 Texelb = _mm256_fmadd_ps(l0, TexelAb, _mm256_fmadd_ps(l1, TexelBb, _mm256_fmadd_ps(l2, TexelCb, _mm256_mul_ps(l3, TexelDb))));
+            __m256 Texela = _mm256_fmadd_ps(l0, TexelAa, _mm256_fmadd_ps(l1, TexelBa, _mm256_fmadd_ps(l2, TexelCa, _mm256_mul_ps(l3, TexelDa))));
+
+            Texelr = _mm256_mul_ps(Texelr, Colorr_8x);
+            Texelg = _mm256_mul_ps(Texelg, Colorg_8x);
+            Texelb = _mm256_mul_ps(Texelb, Colorb_8x);
+            Texela = _mm256_mul_ps(Texela, Colora_8x);
+
+            Texelr = _mm256_min_ps(_mm256_max_ps(Texelr, Zero_8x), MaxColorValue_8x);
+            Texelg = _mm256_min_ps(_mm256_max_ps(Texelg, Zero_8x), MaxColorValue_8x);
+            Texelb = _mm256_min_ps(_mm256_max_ps(Texelb, Zero_8x), MaxColorValue_8x);
+
+            __m256 Blendedr, Blendedg, Blendedb, Blendeda;
+            if (XI >= OpaqueMinX && XI + 8 <= OpaqueMaxX) {
+                // NOTE(sen) Every tap has full alpha, none of the destination shows through
+                Blendedr = Texelr;
+                Blendedg = Texelg;
+                Blendedb = Texelb;
+                Blendeda = Texela;
+            } else {
+                __m256 Destr = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(OriginalDest, 16), MaskFF_8x));
+                __m256 Destg = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(OriginalDest, 8), MaskFF_8x));
+                __m256 Destb = _mm256_cvtepi32_ps(_mm256_and_si256(OriginalDest, MaskFF_8x));
+                __m256 Desta = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(OriginalDest, 24), MaskFF_8x));
+
+                Destr = _mm256_mul_ps(Destr, Destr);
+                Destg = _mm256_mul_ps(Destg, Destg);
+                Destb = _mm256_mul_ps(Destb, Destb);
+
+                __m256 InvTexelA = _mm256_fnmadd_ps(Inv255_8x, Texela, One_8x);
+                Blendedr = _mm256_fmadd_ps(InvTexelA, Destr, Texelr);
+                Blendedg = _mm256_fmadd_ps(InvTexelA, Destg, Texelg);
+                Blendedb = _mm256_fmadd_ps(InvTexelA, Destb, Texelb);
+                Blendeda = _mm256_fmadd_ps(InvTexelA, Desta, Texela);
+            }
+
+            Blendedr = _mm256_mul_ps(_mm256_rsqrt_ps(Blendedr), Blendedr);
+            Blendedg = _mm256_mul_ps(_mm256_rsqrt_ps(Blendedg), Blendedg);
+            Blendedb = _mm256_mul_ps(_mm256_rsqrt_ps(Blendedb), Blendedb);
+
+            __m256i Intr = _mm256_cvtps_epi32(Blendedr);
+            __m256i Intg = _mm256_cvtps_epi32(Blendedg);
+            __m256i Intb = _mm256_cvtps_epi32(Blendedb);
+            __m256i Inta = _mm256_cvtps_epi32(Blendeda);
+
+            __m256i Out = _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi32(Intr, 16), _mm256_slli_epi32(Intg, 8)),
+                _mm256_or_si256(Intb, _mm256_slli_epi32(Inta, 24))
+            );
+
+            __m256i MaskedOut = _mm256_blendv_epi8(OriginalDest, Out, WriteMask);
+
+            if (FullWidth) {
+                _mm256_storeu_si256((__m256i*)Pixel, MaskedOut);
+            } else {
+                _mm_store_si128((__m128i*)Pixel, _mm256_castsi256_si128(MaskedOut));
+            }
+
+            Pixel += 8;
+            PixelPx = _mm256_add_ps(PixelPx, Eight_8x);
+            PixelX = _mm256_add_epi32(PixelX, Eighti_8x);
+        }
+        Row += RowAdvance;
+    }
+}
+
+/// A level of the chain as a bitmap of its own
+internal loaded_bitmap GetMipLevel(loaded_bitmap* Bitmap, uint32 Level) {
+    Assert(Level < Maximum(Bitmap->MipCount, 1));
+    loaded_bitmap Result = *Bitmap;
+    uint8* Memory = (uint8*)Bitmap->Memory;
+    for (uint32 SkipLevel = 0; SkipLevel < Level; ++SkipLevel) {
+        Memory += GetMipLevelTexelCount(Bitmap->Width >> SkipLevel, Bitmap->Height >> SkipLevel, Bitmap->Tiled) *
+            BITMAP_BYTES_PER_PIXEL;
+    }
+    Result.Memory = Memory;
+    Result.Width = Bitmap->Width >> Level;
+    Result.Height = Bitmap->Height >> Level;
+    Result.Pitch = Bitmap->Tiled ? GetTiledPitch(Result.Width) : Result.Width * BITMAP_BYTES_PER_PIXEL;
+    Result.MipCount = 1;
+    Result.MipLevel = Level;
+    return Result;
+}
+
+/// Smallest level that still has at least a texel per pixel along both axes, so the bilinear
+/// fetches stay next to each other instead of striding across the texture. Goes by the less
+/// minified axis, a squashed quad keeps some shimmer along the other one rather than going blurry.
+internal loaded_bitmap SelectMipLevel(loaded_bitmap* Texture, v2 XAxis, v2 YAxis) {
+    loaded_bitmap Result = *Texture;
+    if (Texture->MipCount > 1) {
+        real32 TexelsPerPixelX = (real32)(Texture->Width - 2) / Length(XAxis);
+        real32 TexelsPerPixelY = (real32)(Texture->Height - 2) / Length(YAxis);
+        real32 TexelsPerPixel = Minimum(TexelsPerPixelX, TexelsPerPixelY);
+        uint32 Level = 0;
+        while (Level + 1 < Texture->MipCount && TexelsPerPixel >= 2.0f) {
+            TexelsPerPixel *= 0.5f;
+            ++Level;
+        }
+        if (Level) {
+            Result = GetMipLevel(Texture, Level);
+        }
+    }
+    return Result;
+}
+
+internal void DrawRectangleQuickly(
+    loaded_bitmap* Buffer,
+    v2 Origin, v2 XAxis, v2 YAxis,
+    v4 Color, loaded_bitmap* Texture,
+    real32 PixelsToMeters,
+    rectangle2i ClipRect, bool32 Even
+) {
+    loaded_bitmap MipLevel = SelectMipLevel(Texture, XAxis, YAxis);
+    Texture = &MipLevel;
+
+    if (GetRasterizerSIMD() == RasterizerSIMD_AVX2) {
+        DrawRectangleQuicklyAVX2(Buffer, Origin, XAxis, YAxis, Color, Texture, PixelsToMeters, ClipRect, Even);
+        return;
+    }
+
+    TIMED_FUNCTION();
+
+    Color.rgb *= Color.a;
+
+    real32 XAxisLength = Length(XAxis);
+    real32 YAxisLength = Length(YAxis);
+
+    v2 NxAxis = (YAxisLength / XAxisLength) * XAxis;
+    v2 NyAxis = (XAxisLength / YAxisLength) * YAxis;
+    real32 NzScale = 0.5f * (XAxisLength + YAxisLength);
+
+    int32 WidthMax = Buffer->Width - 3;
+    int32 HeightMax = Buffer->Height - 3;
+
+    rectangle2i FillRect = InvertedInfinityRectangle();
+
+    v2 P[4] = {
+        Origin,
+        Origin + XAxis,
+        Origin + XAxis + YAxis,
+        Origin + YAxis
+    };
+    for (uint32 PIndex = 0; PIndex < ArrayCount(P); PIndex++) {
+        v2 TestP = P[PIndex];
+        int32 FloorX = FloorReal32ToInt32(TestP.x);
+        int32 CeilX = CeilReal32ToInt32(TestP.x) + 1;
+        int32 FloorY = FloorReal32ToInt32(TestP.y);
+        int32 CeilY = CeilReal32ToInt32(TestP.y) + 1;
+        if (FillRect.MinX > FloorX) {
+            FillRect.MinX = FloorX;
+        }
+        if (FillRect.MaxX < CeilX) {
+            FillRect.MaxX = CeilX;
+        }
+        if (FillRect.MinY > FloorY) {
+            FillRect.MinY = FloorY;
+        }
+        if (FillRect.MaxY < CeilY) {
+            FillRect.MaxY = CeilY;
+        }
+    }
+
+    FillRect = Intersect(FillRect, ClipRect);
+    FillRect = Intersect(FillRect, GetCoveredQuadScreenBounds(Texture, Origin, XAxis, YAxis));
+
+    // NOTE(sen) Alternating scanlines
+    if (!Even == (FillRect.MinY & 1)) {
+        FillRect.MinY += 1;
+    }
+
+    if (!HasArea(FillRect)) {
+        return;
+    }
+
+    __m128i StartClipMask = _mm_set1_epi32(-1);
+    __m128i EndClipMask = _mm_set1_epi32(-1);
+    __m128i StartClipMasks[4] = {
+        StartClipMask,
+        _mm_slli_si128(StartClipMask, 1 * 4),
+        _mm_slli_si128(StartClipMask, 2 * 4),
+        _mm_slli_si128(StartClipMask, 3 * 4)
+    };
+    __m128i EndClipMasks[4] = {
+        EndClipMask,
+        _mm_srli_si128(EndClipMask, 3 * 4),
+        _mm_srli_si128(EndClipMask, 2 * 4),
+        _mm_srli_si128(EndClipMask, 1 * 4)
+    };
+    if (FillRect.MinX & 3) {
+        StartClipMask = StartClipMasks[FillRect.MinX & 3];
+        FillRect.MinX = FillRect.MinX & ~3;
+    }
+    if (FillRect.MaxX & 3) {
+        EndClipMask = EndClipMasks[FillRect.MaxX & 3];
+        FillRect.MaxX = (FillRect.MaxX & ~3) + 4;
+    }
+
+    real32 InvXAxisLengthSq = 1 / LengthSq(XAxis);
+    real32 InvYAxisLengthSq = 1 / LengthSq(YAxis);
+
+    v2 nXAxis = XAxis * InvXAxisLengthSq;
+    v2 nYAxis = YAxis * InvYAxisLengthSq;
+
+    __m128 One255_4x = _mm_set1_ps(255.0f);
+    __m128 Half_4x = _mm_set1_ps(0.5f);
+    real32 Inv255 = 1.0f / 255.0f;
+    __m128 Inv255_4x = _mm_set1_ps(Inv255);
+    __m128 One_4x = _mm_set1_ps(1.0f);
+    __m128 Two_4x = _mm_set1_ps(2.0f);
+    __m128 Zero_4x = _mm_set1_ps(0.0f);
+    __m128 Four_4x = _mm_set1_ps(4.0f);
+    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
+    __m128i MaskFFFF_4x = _mm_set1_epi32(0xFFFF);
+    __m128i MaskFF00FF_4x = _mm_set1_epi32(0x00FF00FF);
+    __m128i MaskFF00FF00_4x = _mm_set1_epi32(0xFF00FF00);
+    __m128 MaxColorValue_4x = _mm_set1_ps(255.0f * 255.0f);
+
+    real32 NormalizeC = 1 / 255.0f;
+    real32 NormalizeCSq = Square(NormalizeC);
+    __m128 Colorr_4x = _mm_set1_ps(Color.r);
+    __m128 Colorg_4x = _mm_set1_ps(Color.g);
+    __m128 Colorb_4x = _mm_set1_ps(Color.b);
+    __m128 Colora_4x = _mm_set1_ps(Color.a);
+
+    __m128 nXAxisx_4x = _mm_set1_ps(nXAxis.x);
+    __m128 nXAxisy_4x = _mm_set1_ps(nXAxis.y);
+    __m128 nYAxisx_4x = _mm_set1_ps(nYAxis.x);
+    __m128 nYAxisy_4x = _mm_set1_ps(nYAxis.y);
+
+    __m128 Originx_4x = _mm_set1_ps(Origin.x);
+    __m128 Originy_4x = _mm_set1_ps(Origin.y);
 
     __m128 WidthM2 = _mm_set1_ps((real32)Texture->Width - 2);
     __m128 HeightM2 = _mm_set1_ps((real32)Texture->Height - 2);
@@ -816,6 +1651,9 @@ internal void DrawRectangleQuickly(
     uint8* TextureMemory = (uint8*)Texture->Memory;
     int32 TexturePitch = Texture->Pitch;
     __m128i TexturePitch_4x = _mm_set1_epi32(TexturePitch);
+    bool32 TextureTiled = Texture->Tiled;
+    __m128i TextureBlocksPerRow_4x = _mm_set1_epi32(TexturePitch / (TEXEL_BLOCK_SIDE * TEXEL_BLOCK_SIDE * BITMAP_BYTES_PER_PIXEL));
+    __m128i One_4xi = _mm_set1_epi32(1);
 
     uint8* Row = (uint8*)Buffer->Memory + FillRect.MinY * Buffer->Pitch + FillRect.MinX * BITMAP_BYTES_PER_PIXEL;
     int32 RowAdvance = Buffer->Pitch * 2;
@@ -825,29 +1663,56 @@ internal void DrawRectangleQuickly(
     int32 MaxX = FillRect.MaxX;
     int32 MinX = FillRect.MinX;
 
+    bool32 UseRowSpans = HasCoveredRowSpans(Texture, XAxis, YAxis);
+    bool32 OpaqueColor = Color.a == 1.0f;
+
     TIMED_BLOCK(PixelFill, GetClampedRectArea(FillRect) / 2);
     for (int32 Y = MinY; Y < MaxY; Y += 2) {
 
-        uint32* Pixel = (uint32*)Row;
+        quad_row_span QuadSpan = GetQuadRowSpan(Origin, nXAxis, nYAxis, MinX, MaxX, Y);
+        int32 RowMinX = Maximum(MinX, QuadSpan.MinX & ~3);
+        int32 RowMaxX = Minimum(MaxX, (QuadSpan.MaxX + 3) & ~3);
+        int32 OpaqueMinX = 0;
+        int32 OpaqueMaxX = 0;
+        if (UseRowSpans) {
+            covered_row_span Span = GetCoveredRowSpan(Texture, Origin, XAxis, YAxis, Y);
+            RowMinX = Maximum(RowMinX, Span.MinX & ~3);
+            RowMaxX = Minimum(RowMaxX, (Span.MaxX + 3) & ~3);
+            if (OpaqueColor) {
+                OpaqueMinX = Span.OpaqueMinX;
+                OpaqueMaxX = Span.OpaqueMaxX;
+            }
+        }
+
+        uint32* Pixel = (uint32*)Row + (RowMinX - MinX);
         __m128 PixelPy = _mm_set1_ps((real32)Y);
         PixelPy = _mm_sub_ps(PixelPy, Originy_4x);
         __m128 PynX = _mm_mul_ps(PixelPy, nXAxisy_4x);
         __m128 PynY = _mm_mul_ps(PixelPy, nYAxisy_4x);
 
         __m128 PixelPx = _mm_set_ps(
-            (real32)(MinX + 3),
-            (real32)(MinX + 2),
-            (real32)(MinX + 1),
-            (real32)(MinX + 0)
+            (real32)(RowMinX + 3),
+            (real32)(RowMinX + 2),
+            (real32)(RowMinX + 1),
+            (real32)(RowMinX + 0)
         );
         PixelPx = _mm_sub_ps(PixelPx, Originx_4x);
 
-        __m128i ClipMask = StartClipMask;
+        // NOTE(sen) The clip masks are only for the ends of the fill rect, rows cut short by their
+        // spans stay inside it
+        __m128i ClipMask = RowMinX == MinX ? StartClipMask : _mm_set1_epi32(-1);
+        __m128i RowEndClipMask = RowMaxX == MaxX ? EndClipMask : _mm_set1_epi32(-1);
+        if (RowMinX + 4 >= RowMaxX) {
+            ClipMask = _mm_and_si128(ClipMask, RowEndClipMask);
+        }
 
-        for (int32 XI = MinX; XI < MaxX; XI += 4, PixelPx = _mm_add_ps(PixelPx, Four_4x)) {
+        for (int32 XI = RowMinX; XI < RowMaxX; XI += 4, PixelPx = _mm_add_ps(PixelPx, Four_4x)) {
 
 #define M(a, i) (((real32*)(&(a)))[i])
 #define Mi(a, i) (((uint32*)(&(a)))[i])
+#define mmGatherTexels(Base, Offsets) _mm_setr_epi32( \
+    *(uint32*)((Base) + Mi(Offsets, 0)), *(uint32*)((Base) + Mi(Offsets, 1)), \
+    *(uint32*)((Base) + Mi(Offsets, 2)), *(uint32*)((Base) + Mi(Offsets, 3)))
 #define mmSquare(a) _mm_mul_ps((a), (a))
 
             IACA_VC64_START;
@@ -876,48 +1741,64 @@ internal void DrawRectangleQuickly(
 
 
 #if 1
-            // NOTE(sen) mul by BITMAP_BYTES_PER_PIXEL
-            __m128i FetchX = _mm_slli_epi32(TextureXFloored, 2);
-            __m128i FetchY = _mm_or_si128(
-                _mm_mullo_epi16(TextureYFloored, TexturePitch_4x),
-                _mm_slli_epi32(_mm_mulhi_epi16(TextureYFloored, TexturePitch_4x), 16)
-            );
-            __m128i Fetch_4x = _mm_add_epi32(FetchX, FetchY);
-
-            int32 Fetch0 = Mi(Fetch_4x, 0);
-            int32 Fetch1 = Mi(Fetch_4x, 1);
-            int32 Fetch2 = Mi(Fetch_4x, 2);
-            int32 Fetch3 = Mi(Fetch_4x, 3);
-
-            uint8* TexelPtr0 = TextureMemory + Fetch0;
-            uint8* TexelPtr1 = TextureMemory + Fetch1;
-            uint8* TexelPtr2 = TextureMemory + Fetch2;
-            uint8* TexelPtr3 = TextureMemory + Fetch3;
-
-            __m128i SampleA = _mm_setr_epi32(
-                *(uint32*)TexelPtr0,
-                *(uint32*)TexelPtr1,
-                *(uint32*)TexelPtr2,
-                *(uint32*)TexelPtr3
-            );
-            __m128i SampleB = _mm_setr_epi32(
-                *(uint32*)(TexelPtr0 + BITMAP_BYTES_PER_PIXEL),
-                *(uint32*)(TexelPtr1 + BITMAP_BYTES_PER_PIXEL),
-                *(uint32*)(TexelPtr2 + BITMAP_BYTES_PER_PIXEL),
-                *(uint32*)(TexelPtr3 + BITMAP_BYTES_PER_PIXEL)
-            );
-            __m128i SampleC = _mm_setr_epi32(
-                *(uint32*)(TexelPtr0 + TexturePitch),
-                *(uint32*)(TexelPtr1 + TexturePitch),
-                *(uint32*)(TexelPtr2 + TexturePitch),
-                *(uint32*)(TexelPtr3 + TexturePitch)
-            );
-            __m128i SampleD = _mm_setr_epi32(
-                *(uint32*)(TexelPtr0 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
-                *(uint32*)(TexelPtr1 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
-                *(uint32*)(TexelPtr2 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
-                *(uint32*)(TexelPtr3 + TexturePitch + BITMAP_BYTES_PER_PIXEL)
-            );
+            __m128i SampleA, SampleB, SampleC, SampleD;
+            if (TextureTiled) {
+                __m128i ColumnA = TiledTexelColumnOffset(TextureXFloored);
+                __m128i ColumnB = TiledTexelColumnOffset(_mm_add_epi32(TextureXFloored, One_4xi));
+                __m128i RowA = TiledTexelRowOffset(TextureYFloored, TextureBlocksPerRow_4x);
+                __m128i RowC = TiledTexelRowOffset(_mm_add_epi32(TextureYFloored, One_4xi), TextureBlocksPerRow_4x);
+                __m128i FetchA = _mm_add_epi32(ColumnA, RowA);
+                __m128i FetchB = _mm_add_epi32(ColumnB, RowA);
+                __m128i FetchC = _mm_add_epi32(ColumnA, RowC);
+                __m128i FetchD = _mm_add_epi32(ColumnB, RowC);
+                SampleA = mmGatherTexels(TextureMemory, FetchA);
+                SampleB = mmGatherTexels(TextureMemory, FetchB);
+                SampleC = mmGatherTexels(TextureMemory, FetchC);
+                SampleD = mmGatherTexels(TextureMemory, FetchD);
+            } else {
+                // NOTE(sen) mul by BITMAP_BYTES_PER_PIXEL
+                __m128i FetchX = _mm_slli_epi32(TextureXFloored, 2);
+                __m128i FetchY = _mm_or_si128(
+                    _mm_mullo_epi16(TextureYFloored, TexturePitch_4x),
+                    _mm_slli_epi32(_mm_mulhi_epi16(TextureYFloored, TexturePitch_4x), 16)
+                );
+                __m128i Fetch_4x = _mm_add_epi32(FetchX, FetchY);
+
+                int32 Fetch0 = Mi(Fetch_4x, 0);
+                int32 Fetch1 = Mi(Fetch_4x, 1);
+                int32 Fetch2 = Mi(Fetch_4x, 2);
+                int32 Fetch3 = Mi(Fetch_4x, 3);
+
+                uint8* TexelPtr0 = TextureMemory + Fetch0;
+                uint8* TexelPtr1 = TextureMemory + Fetch1;
+                uint8* TexelPtr2 = TextureMemory + Fetch2;
+                uint8* TexelPtr3 = TextureMemory + Fetch3;
+
+                SampleA = _mm_setr_epi32(
+                    *(uint32*)TexelPtr0,
+                    *(uint32*)TexelPtr1,
+                    *(uint32*)TexelPtr2,
+                    *(uint32*)TexelPtr3
+                );
+                SampleB = _mm_setr_epi32(
+                    *(uint32*)(TexelPtr0 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr1 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr2 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr3 + BITMAP_BYTES_PER_PIXEL)
+                );
+                SampleC = _mm_setr_epi32(
+                    *(uint32*)(TexelPtr0 + TexturePitch),
+                    *(uint32*)(TexelPtr1 + TexturePitch),
+                    *(uint32*)(TexelPtr2 + TexturePitch),
+                    *(uint32*)(TexelPtr3 + TexturePitch)
+                );
+                SampleD = _mm_setr_epi32(
+                    *(uint32*)(TexelPtr0 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr1 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr2 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr3 + TexturePitch + BITMAP_BYTES_PER_PIXEL)
+                );
+            }
 #else
             SampleA = TextureXFloored;
             SampleB = TextureXFloored;
@@ -976,34 +1857,1311 @@ internal void DrawRectangleQuickly(
             __m128 TexelBb = _mm_cvtepi32_ps(_mm_and_si128(SampleB, MaskFF_4x));
             __m128 TexelBa = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleB, 24), MaskFF_4x));
 
-            __m128 TexelCr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleC, 16), MaskFF_4x));
-            __m128 TexelCg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleC, 8), MaskFF_4x));
-            __m128 TexelCb = _mm_cvtepi32_ps(_mm_and_si128(SampleC, MaskFF_4x));
-            __m128 TexelCa = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleC, 24), MaskFF_4x));
+            __m128 TexelCr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleC, 16), MaskFF_4x));
+            __m128 TexelCg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleC, 8), MaskFF_4x));
+            __m128 TexelCb = _mm_cvtepi32_ps(_mm_and_si128(SampleC, MaskFF_4x));
+            __m128 TexelCa = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleC, 24), MaskFF_4x));
+
+            __m128 TexelDr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleD, 16), MaskFF_4x));
+            __m128 TexelDg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleD, 8), MaskFF_4x));
+            __m128 TexelDb = _mm_cvtepi32_ps(_mm_and_si128(SampleD, MaskFF_4x));
+            __m128 TexelDa = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleD, 24), MaskFF_4x));
+
+            TexelAr = mmSquare(TexelAr);
+            TexelAg = mmSquare(TexelAg);
+            TexelAb = mmSquare(TexelAb);
+            TexelBr = mmSquare(TexelBr);
+            TexelBg = mmSquare(TexelBg);
+            TexelBb = mmSquare(TexelBb);
+            TexelCr = mmSquare(TexelCr);
+            TexelCg = mmSquare(TexelCg);
+            TexelCb = mmSquare(TexelCb);
+            TexelDr = mmSquare(TexelDr);
+            TexelDg = mmSquare(TexelDg);
+            TexelDb = mmSquare(TexelDb);
+#endif
+
+            __m128 ifx = _mm_sub_ps(One_4x, TextureXf);
+            __m128 ify = _mm_sub_ps(One_4x, TextureYf);
+
+            __m128 l0 = _mm_mul_ps(ify, ifx);
+            __m128 l1 = _mm_mul_ps(ify, TextureXf);
+            __m128 l2 = _mm_mul_ps(TextureYf, ifx);
+            __m128 l3 = _mm_mul_ps(TextureYf, TextureXf);
+
+            __m128 Texelr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAr), _mm_mul_ps(l1, TexelBr)), _mm_add_ps(_mm_mul_ps(l2, TexelCr), _mm_mul_ps(l3, TexelDr)));
+            __m128 Texelg = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAg), _mm_mul_ps(l1, TexelBg)), _mm_add_ps(_mm_mul_ps(l2, TexelCg), _mm_mul_ps(l3, TexelDg)));
+            __m128 Texelb = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAb), _mm_mul_ps(l1, TexelBb)), _mm_add_ps(_mm_mul_ps(l2, TexelCb), _mm_mul_ps(l3, TexelDb)));
+            __m128 Texela = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAa), _mm_mul_ps(l1, TexelBa)), _mm_add_ps(_mm_mul_ps(l2, TexelCa), _mm_mul_ps(l3, TexelDa)));
+
+            Texelr = _mm_mul_ps(Texelr, Colorr_4x);
+            Texelg = _mm_mul_ps(Texelg, Colorg_4x);
+            Texelb = _mm_mul_ps(Texelb, Colorb_4x);
+            Texela = _mm_mul_ps(Texela, Colora_4x);
+
+            Texelr = _mm_min_ps(_mm_max_ps(Texelr, Zero_4x), MaxColorValue_4x);
+            Texelg = _mm_min_ps(_mm_max_ps(Texelg, Zero_4x), MaxColorValue_4x);
+            Texelb = _mm_min_ps(_mm_max_ps(Texelb, Zero_4x), MaxColorValue_4x);
+
+            __m128 Blendedr, Blendedg, Blendedb, Blendeda;
+            if (XI >= OpaqueMinX && XI + 4 <= OpaqueMaxX) {
+                // NOTE(sen) Every tap has full alpha, none of the destination shows through
+                Blendedr = Texelr;
+                Blendedg = Texelg;
+                Blendedb = Texelb;
+                Blendeda = Texela;
+            } else {
+                __m128 Destr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 16), MaskFF_4x));
+                __m128 Destg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 8), MaskFF_4x));
+                __m128 Destb = _mm_cvtepi32_ps(_mm_and_si128(OriginalDest, MaskFF_4x));
+                __m128 Desta = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 24), MaskFF_4x));
+
+                Destr = mmSquare(Destr);
+                Destg = mmSquare(Destg);
+                Destb = mmSquare(Destb);
+
+                __m128 InvTexelA = _mm_sub_ps(One_4x, _mm_mul_ps(Inv255_4x, Texela));
+                Blendedr = _mm_add_ps(_mm_mul_ps(InvTexelA, Destr), Texelr);
+                Blendedg = _mm_add_ps(_mm_mul_ps(InvTexelA, Destg), Texelg);
+                Blendedb = _mm_add_ps(_mm_mul_ps(InvTexelA, Destb), Texelb);
+                Blendeda = _mm_add_ps(_mm_mul_ps(InvTexelA, Desta), Texela);
+            }
+
+            Blendedr = _mm_mul_ps(_mm_rsqrt_ps(Blendedr), Blendedr);
+            Blendedg = _mm_mul_ps(_mm_rsqrt_ps(Blendedg), Blendedg);
+            Blendedb = _mm_mul_ps(_mm_rsqrt_ps(Blendedb), Blendedb);
+
+            __m128i Intr = _mm_cvtps_epi32(Blendedr);
+            __m128i Intg = _mm_cvtps_epi32(Blendedg);
+            __m128i Intb = _mm_cvtps_epi32(Blendedb);
+            __m128i Inta = _mm_cvtps_epi32(Blendeda);
+
+            __m128i Out = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(Intr, 16), _mm_slli_epi32(Intg, 8)),
+                _mm_or_si128(Intb, _mm_slli_epi32(Inta, 24))
+            );
+#else
+            __m128i Out = _mm_or_si128(TextureXFloored, TextureYFloored);
+#endif
+            __m128i MaskedOut = _mm_or_si128(
+                _mm_and_si128(WriteMask, Out),
+                _mm_andnot_si128(WriteMask, OriginalDest)
+            );
+
+            _mm_store_si128((__m128i*)Pixel, MaskedOut);
+
+            Pixel += 4;
+            ClipMask = _mm_set1_epi32(0xFFFFFFFF);
+
+            if (XI + 8 >= RowMaxX) {
+                ClipMask = RowEndClipMask;
+            }
+
+            IACA_VC64_END;
+        }
+        Row += RowAdvance;
+    }
+    //END_TIMED_BLOCK_COUNTED(ProcessPixel, GetClampedRectArea(FillRect) / 2);
+    //END_TIMED_BLOCK(DrawRectangleQuickly);
+}
+
+// NOTE(sen) Bitmaps are pushed unrotated, so every row of the quad samples the same texel columns
+// and every column the same two texel rows. The columns get worked out once per draw, the rows
+// once per row, and the loop is left with the fetches and the blend. The tables cover the fill
+// rect so this is as wide as we go, tiles are much narrower.
+#define MAX_AXIS_ALIGNED_FILL_WIDTH 2048
+
+/// Per 4 pixels from MinX, all from the same math as DrawRectangleQuickly so the pixels match
+struct axis_aligned_columns {
+    int32 MinX;
+    // NOTE(sen) Byte offsets of the left taps in a texel row
+    __m128i Fetch[MAX_AXIS_ALIGNED_FILL_WIDTH / 4];
+    __m128 Fx[MAX_AXIS_ALIGNED_FILL_WIDTH / 4];
+    // NOTE(sen) Inside both the quad and the fill rect
+    __m128i WriteMask[MAX_AXIS_ALIGNED_FILL_WIDTH / 4];
+    // NOTE(sen) The 4 left taps are neighbouring texels, true 1:1 along the whole row when the
+    // quad is the size of the texture, so they (and the right taps) are a single load
+    bool32 Contiguous[MAX_AXIS_ALIGNED_FILL_WIDTH / 4];
+    // NOTE(sen) Groups with all 4 pixels written, the quad is a single run of pixels so these are
+    // a single run of groups in the middle. Empty at MaxX if there aren't any.
+    int32 InteriorMinX;
+    int32 InteriorMaxX;
+};
+
+internal void BuildAxisAlignedColumns(
+    axis_aligned_columns* Columns, loaded_bitmap* Texture, real32 Originx, real32 Width, rectangle2i FillRect
+) {
+    int32 MinX = FillRect.MinX & ~3;
+    int32 MaxX = (FillRect.MaxX + 3) & ~3;
+    Assert(MaxX - MinX <= MAX_AXIS_ALIGNED_FILL_WIDTH);
+    Columns->MinX = MinX;
+    Columns->InteriorMinX = MaxX;
+    Columns->InteriorMaxX = MaxX;
+
+    __m128 nXAxisx_4x = _mm_set1_ps(Width * (1 / Square(Width)));
+    __m128 WidthM2 = _mm_set1_ps((real32)Texture->Width - 2);
+    __m128 Half_4x = _mm_set1_ps(0.5f);
+    __m128 One_4x = _mm_set1_ps(1.0f);
+    __m128 Zero_4x = _mm_set1_ps(0.0f);
+    __m128i ClipMinX_4x = _mm_set1_epi32(FillRect.MinX - 1);
+    __m128i ClipMaxX_4x = _mm_set1_epi32(FillRect.MaxX);
+
+    __m128i PixelX = _mm_setr_epi32(MinX, MinX + 1, MinX + 2, MinX + 3);
+    for (int32 GroupIndex = 0; GroupIndex < (MaxX - MinX) / 4; ++GroupIndex) {
+        __m128 PixelPx = _mm_sub_ps(_mm_cvtepi32_ps(PixelX), _mm_set1_ps(Originx));
+        __m128 U = _mm_mul_ps(PixelPx, nXAxisx_4x);
+
+        __m128i WriteMask = _mm_castps_si128(_mm_and_ps(_mm_cmpge_ps(U, Zero_4x), _mm_cmple_ps(U, One_4x)));
+        WriteMask = _mm_and_si128(
+            WriteMask, _mm_and_si128(_mm_cmpgt_epi32(PixelX, ClipMinX_4x), _mm_cmplt_epi32(PixelX, ClipMaxX_4x))
+        );
+
+        U = _mm_min_ps(_mm_max_ps(U, Zero_4x), One_4x);
+        __m128 TextureX = _mm_add_ps(_mm_mul_ps(U, WidthM2), Half_4x);
+        __m128i TextureXFloored = _mm_cvttps_epi32(TextureX);
+        __m128i Fetch = _mm_slli_epi32(TextureXFloored, 2);
+
+        Columns->Fetch[GroupIndex] = Fetch;
+        Columns->Fx[GroupIndex] = _mm_sub_ps(TextureX, _mm_cvtepi32_ps(TextureXFloored));
+        Columns->WriteMask[GroupIndex] = WriteMask;
+        Columns->Contiguous[GroupIndex] =
+            Mi(Fetch, 1) == Mi(Fetch, 0) + BITMAP_BYTES_PER_PIXEL &&
+            Mi(Fetch, 2) == Mi(Fetch, 1) + BITMAP_BYTES_PER_PIXEL &&
+            Mi(Fetch, 3) == Mi(Fetch, 2) + BITMAP_BYTES_PER_PIXEL;
+
+        if (_mm_movemask_ps(_mm_castsi128_ps(WriteMask)) == 0xF) {
+            int32 GroupMinX = MinX + GroupIndex * 4;
+            if (Columns->InteriorMinX == MaxX) {
+                Columns->InteriorMinX = GroupMinX;
+            }
+            Columns->InteriorMaxX = GroupMinX + 4;
+        }
+
+        PixelX = _mm_add_epi32(PixelX, _mm_set1_epi32(4));
+    }
+}
+
+/// The texel row V lands on for screen row Y, false if the row is outside the quad
+internal bool32 GetAxisAlignedRow(
+    loaded_bitmap* Texture, real32 Originy, real32 Height, int32 Y, uint8** TexelRow, real32* Fy
+) {
+    real32 V = ((real32)Y - Originy) * (Height * (1 / Square(Height)));
+    bool32 Result = V >= 0.0f && V <= 1.0f;
+    if (Result) {
+        real32 TextureY = V * ((real32)Texture->Height - 2) + 0.5f;
+        int32 TextureYFloored = (int32)TextureY;
+        *TexelRow = (uint8*)Texture->Memory + TextureYFloored * Texture->Pitch;
+        *Fy = TextureY - (real32)TextureYFloored;
+    }
+    return Result;
+}
+
+struct axis_aligned_row_segments {
+    int32 InteriorMinX;
+    int32 OpaqueMinX;
+    int32 OpaqueMaxX;
+    int32 InteriorMaxX;
+};
+
+/// Splits a row into the ends that need masking and the inside that doesn't, and the inside again
+/// around the pixels whose taps are all opaque. Every boundary is a whole number of Steps from
+/// RowMinX, only the last end can finish on a partial one.
+FORCE_INLINE internal axis_aligned_row_segments GetAxisAlignedRowSegments(
+    axis_aligned_columns* Columns, int32 RowMinX, int32 RowMaxX, int32 OpaqueMinX, int32 OpaqueMaxX, int32 Step
+) {
+    int32 StepMask = ~(Step - 1);
+    int32 LastStepX = RowMinX + ((RowMaxX - RowMinX) & StepMask);
+
+    axis_aligned_row_segments Result;
+    Result.InteriorMinX = RowMinX + ((Maximum(Columns->InteriorMinX - RowMinX, 0) + Step - 1) & StepMask);
+    Result.InteriorMinX = Minimum(Result.InteriorMinX, LastStepX);
+    Result.InteriorMaxX = RowMinX + ((Minimum(Columns->InteriorMaxX, RowMaxX) - RowMinX) & StepMask);
+    Result.InteriorMaxX = Maximum(Result.InteriorMaxX, Result.InteriorMinX);
+
+    Result.OpaqueMinX = RowMinX + ((Maximum(OpaqueMinX - RowMinX, 0) + Step - 1) & StepMask);
+    Result.OpaqueMinX = Minimum(Maximum(Result.OpaqueMinX, Result.InteriorMinX), Result.InteriorMaxX);
+    Result.OpaqueMaxX = RowMinX + ((OpaqueMaxX - RowMinX) & StepMask);
+    Result.OpaqueMaxX = Minimum(Maximum(Result.OpaqueMaxX, Result.OpaqueMinX), Result.InteriorMaxX);
+    return Result;
+}
+
+/// 4 pixels for DrawRectangleAxisAlignedSSE2. Always inlined and the flags are always constants,
+/// so every call gets a copy with only the work it needs:
+/// Tinted - Color isn't white, otherwise the texels go out as they are
+/// Masked - some of the pixels are outside the quad or the fill rect
+/// Blended - some of the taps aren't opaque or Color isn't, the destination shows through
+FORCE_INLINE internal void DrawAxisAlignedPixelsSSE2(
+    uint32* Pixel, axis_aligned_columns* Columns, int32 GroupIndex,
+    uint8* TexelRow0, uint8* TexelRow1, real32 Fy, v4 Color,
+    bool32 Tinted, bool32 Masked, bool32 Blended
+) {
+    __m128 Inv255_4x = _mm_set1_ps(1.0f / 255.0f);
+    __m128 One_4x = _mm_set1_ps(1.0f);
+    __m128 Zero_4x = _mm_set1_ps(0.0f);
+    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
+    __m128i MaskFFFF_4x = _mm_set1_epi32(0xFFFF);
+    __m128i MaskFF00FF_4x = _mm_set1_epi32(0x00FF00FF);
+    __m128i MaskFF00FF00_4x = _mm_set1_epi32(0xFF00FF00);
+    __m128 MaxColorValue_4x = _mm_set1_ps(255.0f * 255.0f);
+
+    __m128i Fetch = Columns->Fetch[GroupIndex];
+    __m128 TextureXf = Columns->Fx[GroupIndex];
+    __m128 TextureYf = _mm_set1_ps(Fy);
+
+    __m128i OriginalDest = _mm_setzero_si128();
+    if (Masked || Blended) {
+        OriginalDest = _mm_load_si128((__m128i*)Pixel);
+    }
+
+    __m128i SampleA, SampleB, SampleC, SampleD;
+    if (Columns->Contiguous[GroupIndex]) {
+        uint8* TexelPtr0 = TexelRow0 + Mi(Fetch, 0);
+        uint8* TexelPtr1 = TexelRow1 + Mi(Fetch, 0);
+        SampleA = _mm_loadu_si128((__m128i*)TexelPtr0);
+        SampleB = _mm_loadu_si128((__m128i*)(TexelPtr0 + BITMAP_BYTES_PER_PIXEL));
+        SampleC = _mm_loadu_si128((__m128i*)TexelPtr1);
+        SampleD = _mm_loadu_si128((__m128i*)(TexelPtr1 + BITMAP_BYTES_PER_PIXEL));
+    } else {
+        SampleA = mmGatherTexels(TexelRow0, Fetch);
+        SampleB = mmGatherTexels(TexelRow0 + BITMAP_BYTES_PER_PIXEL, Fetch);
+        SampleC = mmGatherTexels(TexelRow1, Fetch);
+        SampleD = mmGatherTexels(TexelRow1 + BITMAP_BYTES_PER_PIXEL, Fetch);
+    }
+
+    __m128i TexelArb = _mm_and_si128(SampleA, MaskFF00FF_4x);
+    __m128i TexelAag = _mm_and_si128(SampleA, MaskFF00FF00_4x);
+    TexelArb = _mm_mullo_epi16(TexelArb, TexelArb);
+    __m128 TexelAa = _mm_cvtepi32_ps(_mm_srli_epi32(TexelAag, 24));
+    TexelAag = _mm_mulhi_epu16(TexelAag, TexelAag);
+
+    __m128i TexelBrb = _mm_and_si128(SampleB, MaskFF00FF_4x);
+    __m128i TexelBag = _mm_and_si128(SampleB, MaskFF00FF00_4x);
+    TexelBrb = _mm_mullo_epi16(TexelBrb, TexelBrb);
+    __m128 TexelBa = _mm_cvtepi32_ps(_mm_srli_epi32(TexelBag, 24));
+    TexelBag = _mm_mulhi_epu16(TexelBag, TexelBag);
+
+    __m128i TexelCrb = _mm_and_si128(SampleC, MaskFF00FF_4x);
+    __m128i TexelCag = _mm_and_si128(SampleC, MaskFF00FF00_4x);
+    TexelCrb = _mm_mullo_epi16(TexelCrb, TexelCrb);
+    __m128 TexelCa = _mm_cvtepi32_ps(_mm_srli_epi32(TexelCag, 24));
+    TexelCag = _mm_mulhi_epu16(TexelCag, TexelCag);
+
+    __m128i TexelDrb = _mm_and_si128(SampleD, MaskFF00FF_4x);
+    __m128i TexelDag = _mm_and_si128(SampleD, MaskFF00FF00_4x);
+    TexelDrb = _mm_mullo_epi16(TexelDrb, TexelDrb);
+    __m128 TexelDa = _mm_cvtepi32_ps(_mm_srli_epi32(TexelDag, 24));
+    TexelDag = _mm_mulhi_epu16(TexelDag, TexelDag);
+
+    __m128 TexelAr = _mm_cvtepi32_ps(_mm_srli_epi32(TexelArb, 16));
+    __m128 TexelAg = _mm_cvtepi32_ps(_mm_and_si128(TexelAag, MaskFFFF_4x));
+    __m128 TexelAb = _mm_cvtepi32_ps(_mm_and_si128(TexelArb, MaskFFFF_4x));
+
+    __m128 TexelBr = _mm_cvtepi32_ps(_mm_srli_epi32(TexelBrb, 16));
+    __m128 TexelBg = _mm_cvtepi32_ps(_mm_and_si128(TexelBag, MaskFFFF_4x));
+    __m128 TexelBb = _mm_cvtepi32_ps(_mm_and_si128(TexelBrb, MaskFFFF_4x));
+
+    __m128 TexelCr = _mm_cvtepi32_ps(_mm_srli_epi32(TexelCrb, 16));
+    __m128 TexelCg = _mm_cvtepi32_ps(_mm_and_si128(TexelCag, MaskFFFF_4x));
+    __m128 TexelCb = _mm_cvtepi32_ps(_mm_and_si128(TexelCrb, MaskFFFF_4x));
+
+    __m128 TexelDr = _mm_cvtepi32_ps(_mm_srli_epi32(TexelDrb, 16));
+    __m128 TexelDg = _mm_cvtepi32_ps(_mm_and_si128(TexelDag, MaskFFFF_4x));
+    __m128 TexelDb = _mm_cvtepi32_ps(_mm_and_si128(TexelDrb, MaskFFFF_4x));
+
+    __m128 ifx = _mm_sub_ps(One_4x, TextureXf);
+    __m128 ify = _mm_sub_ps(One_4x, TextureYf);
+
+    __m128 l0 = _mm_mul_ps(ify, ifx);
+    __m128 l1 = _mm_mul_ps(ify, TextureXf);
+    __m128 l2 = _mm_mul_ps(TextureYf, ifx);
+    __m128 l3 = _mm_mul_ps(TextureYf, TextureXf);
+
+    __m128 Texelr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAr), _mm_mul_ps(l1, TexelBr)), _mm_add_ps(_mm_mul_ps(l2, TexelCr), _mm_mul_ps(l3, TexelDr)));
+    __m128 Texelg = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAg), _mm_mul_ps(l1, TexelBg)), _mm_add_ps(_mm_mul_ps(l2, TexelCg), _mm_mul_ps(l3, TexelDg)));
+    __m128 Texelb = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAb), _mm_mul_ps(l1, TexelBb)), _mm_add_ps(_mm_mul_ps(l2, TexelCb), _mm_mul_ps(l3, TexelDb)));
+    __m128 Texela = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAa), _mm_mul_ps(l1, TexelBa)), _mm_add_ps(_mm_mul_ps(l2, TexelCa), _mm_mul_ps(l3, TexelDa)));
+
+    if (Tinted) {
+        Texelr = _mm_mul_ps(Texelr, _mm_set1_ps(Color.r));
+        Texelg = _mm_mul_ps(Texelg, _mm_set1_ps(Color.g));
+        Texelb = _mm_mul_ps(Texelb, _mm_set1_ps(Color.b));
+        Texela = _mm_mul_ps(Texela, _mm_set1_ps(Color.a));
+
+        Texelr = _mm_min_ps(_mm_max_ps(Texelr, Zero_4x), MaxColorValue_4x);
+        Texelg = _mm_min_ps(_mm_max_ps(Texelg, Zero_4x), MaxColorValue_4x);
+        Texelb = _mm_min_ps(_mm_max_ps(Texelb, Zero_4x), MaxColorValue_4x);
+    }
+
+    __m128 Blendedr = Texelr;
+    __m128 Blendedg = Texelg;
+    __m128 Blendedb = Texelb;
+    __m128 Blendeda = Texela;
+    if (Blended) {
+        __m128 Destr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 16), MaskFF_4x));
+        __m128 Destg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 8), MaskFF_4x));
+        __m128 Destb = _mm_cvtepi32_ps(_mm_and_si128(OriginalDest, MaskFF_4x));
+        __m128 Desta = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 24), MaskFF_4x));
+
+        Destr = mmSquare(Destr);
+        Destg = mmSquare(Destg);
+        Destb = mmSquare(Destb);
+
+        __m128 InvTexelA = _mm_sub_ps(One_4x, _mm_mul_ps(Inv255_4x, Texela));
+        Blendedr = _mm_add_ps(_mm_mul_ps(InvTexelA, Destr), Texelr);
+        Blendedg = _mm_add_ps(_mm_mul_ps(InvTexelA, Destg), Texelg);
+        Blendedb = _mm_add_ps(_mm_mul_ps(InvTexelA, Destb), Texelb);
+        Blendeda = _mm_add_ps(_mm_mul_ps(InvTexelA, Desta), Texela);
+    }
+
+    Blendedr = _mm_mul_ps(_mm_rsqrt_ps(Blendedr), Blendedr);
+    Blendedg = _mm_mul_ps(_mm_rsqrt_ps(Blendedg), Blendedg);
+    Blendedb = _mm_mul_ps(_mm_rsqrt_ps(Blendedb), Blendedb);
+
+    __m128i Intr = _mm_cvtps_epi32(Blendedr);
+    __m128i Intg = _mm_cvtps_epi32(Blendedg);
+    __m128i Intb = _mm_cvtps_epi32(Blendedb);
+    __m128i Inta = _mm_cvtps_epi32(Blendeda);
+
+    __m128i Out = _mm_or_si128(
+        _mm_or_si128(_mm_slli_epi32(Intr, 16), _mm_slli_epi32(Intg, 8)),
+        _mm_or_si128(Intb, _mm_slli_epi32(Inta, 24))
+    );
+    if (Masked) {
+        __m128i WriteMask = Columns->WriteMask[GroupIndex];
+        Out = _mm_or_si128(_mm_and_si128(WriteMask, Out), _mm_andnot_si128(WriteMask, OriginalDest));
+    }
+
+    _mm_store_si128((__m128i*)Pixel, Out);
+}
+
+FORCE_INLINE internal void DrawRectangleAxisAlignedSSE2_(
+    loaded_bitmap* Buffer, axis_aligned_columns* Columns, rectangle2i FillRect,
+    v2 Origin, v2 Size, v4 Color, loaded_bitmap* Texture, bool32 Tinted
+) {
+    Color.rgb *= Color.a;
+
+    v2 XAxis = V2(Size.x, 0);
+    v2 YAxis = V2(0, Size.y);
+
+    int32 TexturePitch = Texture->Pitch;
+
+    int32 MinX = Columns->MinX;
+    int32 MaxX = (FillRect.MaxX + 3) & ~3;
+
+    bool32 UseRowSpans = HasCoveredRowSpans(Texture, XAxis, YAxis);
+    bool32 OpaqueColor = Color.a == 1.0f;
+
+    TIMED_BLOCK(PixelFill, GetClampedRectArea(FillRect) / 2);
+    for (int32 Y = FillRect.MinY; Y < FillRect.MaxY; Y += 2) {
+
+        uint8* TexelRow0;
+        real32 Fy;
+        if (!GetAxisAlignedRow(Texture, Origin.y, Size.y, Y, &TexelRow0, &Fy)) {
+            continue;
+        }
+        uint8* TexelRow1 = TexelRow0 + TexturePitch;
+
+        int32 RowMinX = MinX;
+        int32 RowMaxX = MaxX;
+        int32 OpaqueMinX = 0;
+        int32 OpaqueMaxX = 0;
+        if (UseRowSpans) {
+            covered_row_span Span = GetCoveredRowSpan(Texture, Origin, XAxis, YAxis, Y);
+            RowMinX = Maximum(MinX, Span.MinX & ~3);
+            RowMaxX = Minimum(MaxX, (Span.MaxX + 3) & ~3);
+            if (OpaqueColor) {
+                OpaqueMinX = Span.OpaqueMinX;
+                OpaqueMaxX = Span.OpaqueMaxX;
+            }
+        }
+        axis_aligned_row_segments Segments =
+            GetAxisAlignedRowSegments(Columns, RowMinX, RowMaxX, OpaqueMinX, OpaqueMaxX, 4);
+
+        uint32* Pixel = (uint32*)((uint8*)Buffer->Memory + Y * Buffer->Pitch) + RowMinX;
+        int32 XI = RowMinX;
+        for (; XI < Segments.InteriorMinX; XI += 4, Pixel += 4) {
+            int32 GroupIndex = (XI - MinX) / 4;
+            if (XI >= OpaqueMinX && XI + 4 <= OpaqueMaxX) {
+                DrawAxisAlignedPixelsSSE2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, false);
+            } else {
+                DrawAxisAlignedPixelsSSE2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, true);
+            }
+        }
+        for (; XI < Segments.OpaqueMinX; XI += 4, Pixel += 4) {
+            DrawAxisAlignedPixelsSSE2(Pixel, Columns, (XI - MinX) / 4, TexelRow0, TexelRow1, Fy, Color, Tinted, false, true);
+        }
+        for (; XI < Segments.OpaqueMaxX; XI += 4, Pixel += 4) {
+            DrawAxisAlignedPixelsSSE2(Pixel, Columns, (XI - MinX) / 4, TexelRow0, TexelRow1, Fy, Color, Tinted, false, false);
+        }
+        for (; XI < Segments.InteriorMaxX; XI += 4, Pixel += 4) {
+            DrawAxisAlignedPixelsSSE2(Pixel, Columns, (XI - MinX) / 4, TexelRow0, TexelRow1, Fy, Color, Tinted, false, true);
+        }
+        for (; XI < RowMaxX; XI += 4, Pixel += 4) {
+            int32 GroupIndex = (XI - MinX) / 4;
+            if (XI >= OpaqueMinX && XI + 4 <= OpaqueMaxX) {
+                DrawAxisAlignedPixelsSSE2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, false);
+            } else {
+                DrawAxisAlignedPixelsSSE2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, true);
+            }
+        }
+    }
+}
+
+/// White entries (most of them) get a copy without the tint
+internal void DrawRectangleAxisAlignedSSE2(
+    loaded_bitmap* Buffer, axis_aligned_columns* Columns, rectangle2i FillRect,
+    v2 Origin, v2 Size, v4 Color, loaded_bitmap* Texture
+) {
+    TIMED_FUNCTION();
+    if (Color.r == 1.0f && Color.g == 1.0f && Color.b == 1.0f && Color.a == 1.0f) {
+        DrawRectangleAxisAlignedSSE2_(Buffer, Columns, FillRect, Origin, Size, Color, Texture, false);
+    } else {
+        DrawRectangleAxisAlignedSSE2_(Buffer, Columns, FillRect, Origin, Size, Color, Texture, true);
+    }
+}
+
+/// 8 pixels for DrawRectangleAxisAlignedAVX2, same flags as DrawAxisAlignedPixelsSSE2. Without
+/// FullWidth only the low 4 are read and written.
+TARGET_AVX2 FORCE_INLINE internal void DrawAxisAlignedPixelsAVX2(
+    uint32* Pixel, axis_aligned_columns* Columns, int32 GroupIndex,
+    uint8* TexelRow0, uint8* TexelRow1, real32 Fy, v4 Color,
+    bool32 Tinted, bool32 Masked, bool32 Blended, bool32 FullWidth
+) {
+    __m256 Inv255_8x = _mm256_set1_ps(1.0f / 255.0f);
+    __m256 One_8x = _mm256_set1_ps(1.0f);
+    __m256 Zero_8x = _mm256_set1_ps(0.0f);
+    __m256i MaskFF_8x = _mm256_set1_epi32(0xFF);
+    __m256i MaskFFFF_8x = _mm256_set1_epi32(0xFFFF);
+    __m256i MaskFF00FF_8x = _mm256_set1_epi32(0x00FF00FF);
+    __m256i MaskFF00FF00_8x = _mm256_set1_epi32(0xFF00FF00);
+    __m256 MaxColorValue_8x = _mm256_set1_ps(255.0f * 255.0f);
+
+    __m256i Fetch;
+    __m256 TextureXf;
+    __m256i OriginalDest = _mm256_setzero_si256();
+    bool32 Contiguous;
+    if (FullWidth) {
+        Fetch = _mm256_loadu_si256((__m256i*)(Columns->Fetch + GroupIndex));
+        TextureXf = _mm256_loadu_ps((real32*)(Columns->Fx + GroupIndex));
+        if (Masked || Blended) {
+            OriginalDest = _mm256_loadu_si256((__m256i*)Pixel);
+        }
+        Contiguous =
+            Columns->Contiguous[GroupIndex] && Columns->Contiguous[GroupIndex + 1] &&
+            Mi8(Fetch, 4) == Mi8(Fetch, 3) + BITMAP_BYTES_PER_PIXEL;
+    } else {
+        // NOTE(sen) The gathers read all 8 lanes, zero offsets keep the upper ones on the first texel
+        Fetch = _mm256_inserti128_si256(_mm256_setzero_si256(), Columns->Fetch[GroupIndex], 0);
+        TextureXf = _mm256_insertf128_ps(_mm256_setzero_ps(), Columns->Fx[GroupIndex], 0);
+        if (Masked || Blended) {
+            OriginalDest = _mm256_inserti128_si256(_mm256_setzero_si256(), _mm_load_si128((__m128i*)Pixel), 0);
+        }
+        // NOTE(sen) A full load could read past the end of the last texel row
+        Contiguous = false;
+    }
+    __m256 TextureYf = _mm256_set1_ps(Fy);
+
+    __m256i SampleA, SampleB, SampleC, SampleD;
+    if (Contiguous) {
+        uint8* TexelPtr0 = TexelRow0 + Mi8(Fetch, 0);
+        uint8* TexelPtr1 = TexelRow1 + Mi8(Fetch, 0);
+        SampleA = _mm256_loadu_si256((__m256i*)TexelPtr0);
+        SampleB = _mm256_loadu_si256((__m256i*)(TexelPtr0 + BITMAP_BYTES_PER_PIXEL));
+        SampleC = _mm256_loadu_si256((__m256i*)TexelPtr1);
+        SampleD = _mm256_loadu_si256((__m256i*)(TexelPtr1 + BITMAP_BYTES_PER_PIXEL));
+    } else {
+        SampleA = mmGatherTexels8(TexelRow0, Fetch);
+        SampleB = mmGatherTexels8(TexelRow0 + BITMAP_BYTES_PER_PIXEL, Fetch);
+        SampleC = mmGatherTexels8(TexelRow1, Fetch);
+        SampleD = mmGatherTexels8(TexelRow1 + BITMAP_BYTES_PER_PIXEL, Fetch);
+    }
+
+    __m256i TexelArb = _mm256_and_si256(SampleA, MaskFF00FF_8x);
+    __m256i TexelAag = _mm256_and_si256(SampleA, MaskFF00FF00_8x);
+    TexelArb = _mm256_mullo_epi16(TexelArb, TexelArb);
+    __m256 TexelAa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelAag, 24));
+    TexelAag = _mm256_mulhi_epu16(TexelAag, TexelAag);
+
+    __m256i TexelBrb = _mm256_and_si256(SampleB, MaskFF00FF_8x);
+    __m256i TexelBag = _mm256_and_si256(SampleB, MaskFF00FF00_8x);
+    TexelBrb = _mm256_mullo_epi16(TexelBrb, TexelBrb);
+    __m256 TexelBa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelBag, 24));
+    TexelBag = _mm256_mulhi_epu16(TexelBag, TexelBag);
+
+    __m256i TexelCrb = _mm256_and_si256(SampleC, MaskFF00FF_8x);
+    __m256i TexelCag = _mm256_and_si256(SampleC, MaskFF00FF00_8x);
+    TexelCrb = _mm256_mullo_epi16(TexelCrb, TexelCrb);
+    __m256 TexelCa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelCag, 24));
+    TexelCag = _mm256_mulhi_epu16(TexelCag, TexelCag);
+
+    __m256i TexelDrb = _mm256_and_si256(SampleD, MaskFF00FF_8x);
+    __m256i TexelDag = _mm256_and_si256(SampleD, MaskFF00FF00_8x);
+    TexelDrb = _mm256_mullo_epi16(TexelDrb, TexelDrb);
+    __m256 TexelDa = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelDag, 24));
+    TexelDag = _mm256_mulhi_epu16(TexelDag, TexelDag);
+
+    __m256 TexelAr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelArb, 16));
+    __m256 TexelAg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelAag, MaskFFFF_8x));
+    __m256 TexelAb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelArb, MaskFFFF_8x));
+
+    __m256 TexelBr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelBrb, 16));
+    __m256 TexelBg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelBag, MaskFFFF_8x));
+    __m256 TexelBb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelBrb, MaskFFFF_8x));
+
+    __m256 TexelCr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelCrb, 16));
+    __m256 TexelCg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelCag, MaskFFFF_8x));
+    __m256 TexelCb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelCrb, MaskFFFF_8x));
+
+    __m256 TexelDr = _mm256_cvtepi32_ps(_mm256_srli_epi32(TexelDrb, 16));
+    __m256 TexelDg = _mm256_cvtepi32_ps(_mm256_and_si256(TexelDag, MaskFFFF_8x));
+    __m256 TexelDb = _mm256_cvtepi32_ps(_mm256_and_si256(TexelDrb, MaskFFFF_8x));
+
+    __m256 ifx = _mm256_sub_ps(One_8x, TextureXf);
+    __m256 ify = _mm256_sub_ps(One_8x, TextureYf);
+
+    __m256 l0 = _mm256_mul_ps(ify, ifx);
+    __m256 l1 = _mm256_mul_ps(ify, TextureXf);
+    __m256 l2 = _mm256_mul_ps(TextureYf, ifx);
+    __m256 l3 = _mm256_mul_ps(TextureYf, TextureXf);
+
+    __m256 Texelr = _mm256_fmadd_ps(l0, TexelAr, _mm256_fmadd_ps(l1, TexelBr, _mm256_fmadd_ps(l2, TexelCr, _mm256_mul_ps(l3, TexelDr))));
+    __m256 Texelg = _mm256_fmadd_ps(l0, TexelAg, _mm256_fmadd_ps(l1, TexelBg, _mm256_fmadd_ps(l2, TexelCg, _mm256_mul_ps(l3, TexelDg))));
+    __m256 Texelb = _mm256_fmadd_ps(l0, TexelAb, _mm256_fmadd_ps(l1, TexelBb, _mm256_fmadd_ps(l2, TexelCb, _mm256_mul_ps(l3, TexelDb))));
+    __m256 Texela = _mm256_fmadd_ps(l0, TexelAa, _mm256_fmadd_ps(l1, TexelBa, _mm256_fmadd_ps(l2, TexelCa, _mm256_mul_ps(l3, TexelDa))));
+
+    if (Tinted) {
+        Texelr = _mm256_mul_ps(Texelr, _mm256_set1_ps(Color.r));
+        Texelg = _mm256_mul_ps(Texelg, _mm256_set1_ps(Color.g));
+        Texelb = _mm256_mul_ps(Texelb, _mm256_set1_ps(Color.b));
+        Texela = _mm256_mul_ps(Texela, _mm256_set1_ps(Color.a));
+
+        Texelr = _mm256_min_ps(_mm256_max_ps(Texelr, Zero_8x), MaxColorValue_8x);
+        Texelg = _mm256_min_ps(_mm256_max_ps(Texelg, Zero_8x), MaxColorValue_8x);
+        Texelb = _mm256_min_ps(_mm256_max_ps(Texelb, Zero_8x), MaxColorValue_8x);
+    }
+
+    __m256 Blendedr = Texelr;
+    __m256 Blendedg = Texelg;
+    __m256 Blendedb = Texelb;
+    __m256 Blendeda = Texela;
+    if (Blended) {
+        __m256 Destr = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(OriginalDest, 16), MaskFF_8x));
+        __m256 Destg = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(OriginalDest, 8), MaskFF_8x));
+        __m256 Destb = _mm256_cvtepi32_ps(_mm256_and_si256(OriginalDest, MaskFF_8x));
+        __m256 Desta = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(OriginalDest, 24), MaskFF_8x));
+
+        Destr = _mm256_mul_ps(Destr, Destr);
+        Destg = _mm256_mul_ps(Destg, Destg);
+        Destb = _mm256_mul_ps(Destb, Destb);
+
+        __m256 InvTexelA = _mm256_fnmadd_ps(Inv255_8x, Texela, One_8x);
+        Blendedr = _mm256_fmadd_ps(InvTexelA, Destr, Texelr);
+        Blendedg = _mm256_fmadd_ps(InvTexelA, Destg, Texelg);
+        Blendedb = _mm256_fmadd_ps(InvTexelA, Destb, Texelb);
+        Blendeda = _mm256_fmadd_ps(InvTexelA, Desta, Texela);
+    }
+
+    Blendedr = _mm256_mul_ps(_mm256_rsqrt_ps(Blendedr), Blendedr);
+    Blendedg = _mm256_mul_ps(_mm256_rsqrt_ps(Blendedg), Blendedg);
+    Blendedb = _mm256_mul_ps(_mm256_rsqrt_ps(Blendedb), Blendedb);
+
+    __m256i Intr = _mm256_cvtps_epi32(Blendedr);
+    __m256i Intg = _mm256_cvtps_epi32(Blendedg);
+    __m256i Intb = _mm256_cvtps_epi32(Blendedb);
+    __m256i Inta = _mm256_cvtps_epi32(Blendeda);
+
+    __m256i Out = _mm256_or_si256(
+        _mm256_or_si256(_mm256_slli_epi32(Intr, 16), _mm256_slli_epi32(Intg, 8)),
+        _mm256_or_si256(Intb, _mm256_slli_epi32(Inta, 24))
+    );
+    if (Masked) {
+        __m256i WriteMask;
+        if (FullWidth) {
+            WriteMask = _mm256_loadu_si256((__m256i*)(Columns->WriteMask + GroupIndex));
+        } else {
+            WriteMask = _mm256_inserti128_si256(_mm256_setzero_si256(), Columns->WriteMask[GroupIndex], 0);
+        }
+        Out = _mm256_blendv_epi8(OriginalDest, Out, WriteMask);
+    }
+
+    if (FullWidth) {
+        _mm256_storeu_si256((__m256i*)Pixel, Out);
+    } else {
+        _mm_store_si128((__m128i*)Pixel, _mm256_castsi256_si128(Out));
+    }
+}
+
+// NOTE(sen) 8 pixels at a time from two entries of the column tables, see the general AVX2
+// version for the trailing 4
+TARGET_AVX2 FORCE_INLINE internal void DrawRectangleAxisAlignedAVX2_(
+    loaded_bitmap* Buffer, axis_aligned_columns* Columns, rectangle2i FillRect,
+    v2 Origin, v2 Size, v4 Color, loaded_bitmap* Texture, bool32 Tinted
+) {
+    Color.rgb *= Color.a;
+
+    v2 XAxis = V2(Size.x, 0);
+    v2 YAxis = V2(0, Size.y);
+
+    int32 TexturePitch = Texture->Pitch;
+
+    int32 MinX = Columns->MinX;
+    int32 MaxX = (FillRect.MaxX + 3) & ~3;
+
+    bool32 UseRowSpans = HasCoveredRowSpans(Texture, XAxis, YAxis);
+    bool32 OpaqueColor = Color.a == 1.0f;
+
+    TIMED_BLOCK(PixelFill, GetClampedRectArea(FillRect) / 2);
+    for (int32 Y = FillRect.MinY; Y < FillRect.MaxY; Y += 2) {
+
+        uint8* TexelRow0;
+        real32 Fy;
+        if (!GetAxisAlignedRow(Texture, Origin.y, Size.y, Y, &TexelRow0, &Fy)) {
+            continue;
+        }
+        uint8* TexelRow1 = TexelRow0 + TexturePitch;
+
+        int32 RowMinX = MinX;
+        int32 RowMaxX = MaxX;
+        int32 OpaqueMinX = 0;
+        int32 OpaqueMaxX = 0;
+        if (UseRowSpans) {
+            covered_row_span Span = GetCoveredRowSpan(Texture, Origin, XAxis, YAxis, Y);
+            RowMinX = Maximum(MinX, Span.MinX & ~3);
+            RowMaxX = Minimum(MaxX, (Span.MaxX + 3) & ~3);
+            if (OpaqueColor) {
+                OpaqueMinX = Span.OpaqueMinX;
+                OpaqueMaxX = Span.OpaqueMaxX;
+            }
+        }
+        axis_aligned_row_segments Segments =
+            GetAxisAlignedRowSegments(Columns, RowMinX, RowMaxX, OpaqueMinX, OpaqueMaxX, 8);
+
+        uint32* Pixel = (uint32*)((uint8*)Buffer->Memory + Y * Buffer->Pitch) + RowMinX;
+        int32 XI = RowMinX;
+        for (; XI < Segments.InteriorMinX; XI += 8, Pixel += 8) {
+            int32 GroupIndex = (XI - MinX) / 4;
+            if (XI >= OpaqueMinX && XI + 8 <= OpaqueMaxX) {
+                DrawAxisAlignedPixelsAVX2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, false, true);
+            } else {
+                DrawAxisAlignedPixelsAVX2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, true, true);
+            }
+        }
+        for (; XI < Segments.OpaqueMinX; XI += 8, Pixel += 8) {
+            DrawAxisAlignedPixelsAVX2(Pixel, Columns, (XI - MinX) / 4, TexelRow0, TexelRow1, Fy, Color, Tinted, false, true, true);
+        }
+        for (; XI < Segments.OpaqueMaxX; XI += 8, Pixel += 8) {
+            DrawAxisAlignedPixelsAVX2(Pixel, Columns, (XI - MinX) / 4, TexelRow0, TexelRow1, Fy, Color, Tinted, false, false, true);
+        }
+        for (; XI < Segments.InteriorMaxX; XI += 8, Pixel += 8) {
+            DrawAxisAlignedPixelsAVX2(Pixel, Columns, (XI - MinX) / 4, TexelRow0, TexelRow1, Fy, Color, Tinted, false, true, true);
+        }
+        for (; XI + 8 <= RowMaxX; XI += 8, Pixel += 8) {
+            int32 GroupIndex = (XI - MinX) / 4;
+            if (XI >= OpaqueMinX && XI + 8 <= OpaqueMaxX) {
+                DrawAxisAlignedPixelsAVX2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, false, true);
+            } else {
+                DrawAxisAlignedPixelsAVX2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, true, true);
+            }
+        }
+        if (XI < RowMaxX) {
+            int32 GroupIndex = (XI - MinX) / 4;
+            if (XI >= OpaqueMinX && XI + 4 <= OpaqueMaxX) {
+                DrawAxisAlignedPixelsAVX2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, false, false);
+            } else {
+                DrawAxisAlignedPixelsAVX2(Pixel, Columns, GroupIndex, TexelRow0, TexelRow1, Fy, Color, Tinted, true, true, false);
+            }
+        }
+    }
+}
+
+TARGET_AVX2 internal void DrawRectangleAxisAlignedAVX2(
+    loaded_bitmap* Buffer, axis_aligned_columns* Columns, rectangle2i FillRect,
+    v2 Origin, v2 Size, v4 Color, loaded_bitmap* Texture
+) {
+    TIMED_FUNCTION();
+    if (Color.r == 1.0f && Color.g == 1.0f && Color.b == 1.0f && Color.a == 1.0f) {
+        DrawRectangleAxisAlignedAVX2_(Buffer, Columns, FillRect, Origin, Size, Color, Texture, false);
+    } else {
+        DrawRectangleAxisAlignedAVX2_(Buffer, Columns, FillRect, Origin, Size, Color, Texture, true);
+    }
+}
+
+/// Bitmap entries are never rotated, they come here instead of DrawRectangleQuickly. Textures
+/// the kernels above can't take (tiled, or a fill rect wider than the tables) still go there.
+internal void DrawRectangleAxisAligned(
+    loaded_bitmap* Buffer,
+    v2 Origin, v2 Size,
+    v4 Color, loaded_bitmap* Texture,
+    real32 PixelsToMeters,
+    rectangle2i ClipRect, bool32 Even
+) {
+    if (Size.x == 0 || Size.y == 0) {
+        return;
+    }
+    v2 XAxis = V2(Size.x, 0);
+    v2 YAxis = V2(0, Size.y);
+
+    loaded_bitmap MipLevel = SelectMipLevel(Texture, XAxis, YAxis);
+
+    rectangle2i FillRect = Intersect(GetQuadScreenBounds(Origin, XAxis, YAxis), ClipRect);
+    FillRect = Intersect(FillRect, GetCoveredQuadScreenBounds(&MipLevel, Origin, XAxis, YAxis));
+
+    // NOTE(sen) Alternating scanlines
+    if (!Even == (FillRect.MinY & 1)) {
+        FillRect.MinY += 1;
+    }
+
+    if (!HasArea(FillRect)) {
+        return;
+    }
+
+    if (MipLevel.Tiled || ((FillRect.MaxX + 3) & ~3) - (FillRect.MinX & ~3) > MAX_AXIS_ALIGNED_FILL_WIDTH) {
+        DrawRectangleQuickly(Buffer, Origin, XAxis, YAxis, Color, Texture, PixelsToMeters, ClipRect, Even);
+        return;
+    }
+
+    axis_aligned_columns Columns;
+    BuildAxisAlignedColumns(&Columns, &MipLevel, Origin.x, Size.x, FillRect);
+    if (GetRasterizerSIMD() == RasterizerSIMD_AVX2) {
+        DrawRectangleAxisAlignedAVX2(Buffer, &Columns, FillRect, Origin, Size, Color, &MipLevel);
+    } else {
+        DrawRectangleAxisAlignedSSE2(Buffer, &Columns, FillRect, Origin, Size, Color, &MipLevel);
+    }
+}
+
+// NOTE(sen) The fixed point pipeline keeps linear color in 16 bits, 0-65535
+global_variable uint8 GlobalLinear12ToSRGB8[4096];
+global_variable bool32 volatile GlobalSRGBTablesInitialized;
+
+/// Same curve as Linear1ToSRGB255 so both pipelines agree
+internal void InitSRGBTables() {
+    if (!GlobalSRGBTablesInitialized) {
+        for (uint32 Index = 0; Index < ArrayCount(GlobalLinear12ToSRGB8); ++Index) {
+            // NOTE(sen) Middle of the range of 16-bit values that share this index
+            real32 Linear = ((real32)Index + 0.5f) / (real32)ArrayCount(GlobalLinear12ToSRGB8);
+            GlobalLinear12ToSRGB8[Index] = (uint8)RoundReal32ToUint32(Linear1ToSRGB255(V4(Linear, 0, 0, 0)).r);
+        }
+        GlobalLinear12ToSRGB8[0] = 0;
+        CompletePreviousWritesBeforeFutureWrites;
+        GlobalSRGBTablesInitialized = true;
+    }
+}
+
+/// DrawRectangleQuickly with 16-bit fixed point bilinear filtering and blending. Only texture
+/// coordinates are float. Texels and the destination are squared in 16-bit lanes and the result goes
+/// through the linear->sRGB table.
+internal void DrawRectangleQuicklyFixed(
+    loaded_bitmap* Buffer,
+    v2 Origin, v2 XAxis, v2 YAxis,
+    v4 Color, loaded_bitmap* Texture,
+    rectangle2i ClipRect, bool32 Even
+) {
+    TIMED_FUNCTION();
+
+    Color.rgb *= Color.a;
+
+    loaded_bitmap MipLevel = SelectMipLevel(Texture, XAxis, YAxis);
+    Texture = &MipLevel;
+
+    rectangle2i FillRect = Intersect(GetCoveredQuadScreenBounds(Texture, Origin, XAxis, YAxis), ClipRect);
+
+    // NOTE(sen) Alternating scanlines
+    if (!Even == (FillRect.MinY & 1)) {
+        FillRect.MinY += 1;
+    }
+
+    if (!HasArea(FillRect)) {
+        return;
+    }
+
+    __m128i ClipMinX_4x = _mm_set1_epi32(FillRect.MinX - 1);
+    __m128i ClipMaxX_4x = _mm_set1_epi32(FillRect.MaxX);
+    FillRect.MinX = FillRect.MinX & ~3;
+    FillRect.MaxX = (FillRect.MaxX + 3) & ~3;
+
+    real32 InvXAxisLengthSq = 1 / LengthSq(XAxis);
+    real32 InvYAxisLengthSq = 1 / LengthSq(YAxis);
+
+    v2 nXAxis = XAxis * InvXAxisLengthSq;
+    v2 nYAxis = YAxis * InvYAxisLengthSq;
+
+    __m128 Half_4x = _mm_set1_ps(0.5f);
+    __m128 One_4x = _mm_set1_ps(1.0f);
+    __m128 Zero_4x = _mm_set1_ps(0.0f);
+    __m128 Four_4x = _mm_set1_ps(4.0f);
+    __m128 One16_4x = _mm_set1_ps(65535.0f);
+    __m128i Fouri_4x = _mm_set1_epi32(4);
+    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
+    __m128i MaskFFFF_4x = _mm_set1_epi32(0xFFFF);
+    __m128i MaskFF00FF_4x = _mm_set1_epi32(0x00FF00FF);
+    __m128i MaskFF00FF00_4x = _mm_set1_epi32(0xFF00FF00);
+    __m128i Alpha8To16_4x = _mm_set1_epi32(257);
+
+    __m128i Colorr_4x = _mm_set1_epi32(RoundReal32ToUint32(Clamp01(Color.r) * 65535.0f));
+    __m128i Colorg_4x = _mm_set1_epi32(RoundReal32ToUint32(Clamp01(Color.g) * 65535.0f));
+    __m128i Colorb_4x = _mm_set1_epi32(RoundReal32ToUint32(Clamp01(Color.b) * 65535.0f));
+    __m128i Colora_4x = _mm_set1_epi32(RoundReal32ToUint32(Clamp01(Color.a) * 65535.0f));
+
+    __m128 nXAxisx_4x = _mm_set1_ps(nXAxis.x);
+    __m128 nXAxisy_4x = _mm_set1_ps(nXAxis.y);
+    __m128 nYAxisx_4x = _mm_set1_ps(nYAxis.x);
+    __m128 nYAxisy_4x = _mm_set1_ps(nYAxis.y);
+
+    __m128 Originx_4x = _mm_set1_ps(Origin.x);
+    __m128 Originy_4x = _mm_set1_ps(Origin.y);
+
+    __m128 WidthM2 = _mm_set1_ps((real32)Texture->Width - 2);
+    __m128 HeightM2 = _mm_set1_ps((real32)Texture->Height - 2);
+
+    uint8* TextureMemory = (uint8*)Texture->Memory;
+    int32 TexturePitch = Texture->Pitch;
+    __m128i TexturePitch_4x = _mm_set1_epi32(TexturePitch);
+    bool32 TextureTiled = Texture->Tiled;
+    __m128i TextureBlocksPerRow_4x = _mm_set1_epi32(TexturePitch / (TEXEL_BLOCK_SIDE * TEXEL_BLOCK_SIDE * BITMAP_BYTES_PER_PIXEL));
+    __m128i One_4xi = _mm_set1_epi32(1);
+
+    uint8* Linear12ToSRGB8 = GlobalLinear12ToSRGB8;
+
+    uint8* Row = (uint8*)Buffer->Memory + FillRect.MinY * Buffer->Pitch + FillRect.MinX * BITMAP_BYTES_PER_PIXEL;
+    int32 RowAdvance = Buffer->Pitch * 2;
+
+    int32 MaxY = FillRect.MaxY;
+    int32 MinY = FillRect.MinY;
+    int32 MaxX = FillRect.MaxX;
+    int32 MinX = FillRect.MinX;
+
+    bool32 UseRowSpans = HasCoveredRowSpans(Texture, XAxis, YAxis);
+    bool32 OpaqueColor = Color.a == 1.0f;
+
+    TIMED_BLOCK(PixelFillFixed, GetClampedRectArea(FillRect) / 2);
+    for (int32 Y = MinY; Y < MaxY; Y += 2) {
+
+        quad_row_span QuadSpan = GetQuadRowSpan(Origin, nXAxis, nYAxis, MinX, MaxX, Y);
+        int32 RowMinX = Maximum(MinX, QuadSpan.MinX & ~3);
+        int32 RowMaxX = Minimum(MaxX, (QuadSpan.MaxX + 3) & ~3);
+        int32 OpaqueMinX = 0;
+        int32 OpaqueMaxX = 0;
+        if (UseRowSpans) {
+            covered_row_span Span = GetCoveredRowSpan(Texture, Origin, XAxis, YAxis, Y);
+            RowMinX = Maximum(RowMinX, Span.MinX & ~3);
+            RowMaxX = Minimum(RowMaxX, (Span.MaxX + 3) & ~3);
+            if (OpaqueColor) {
+                OpaqueMinX = Span.OpaqueMinX;
+                OpaqueMaxX = Span.OpaqueMaxX;
+            }
+        }
+
+        uint32* Pixel = (uint32*)Row + (RowMinX - MinX);
+        __m128 PixelPy = _mm_sub_ps(_mm_set1_ps((real32)Y), Originy_4x);
+        __m128 PynX = _mm_mul_ps(PixelPy, nXAxisy_4x);
+        __m128 PynY = _mm_mul_ps(PixelPy, nYAxisy_4x);
+
+        __m128i PixelX = _mm_setr_epi32(RowMinX, RowMinX + 1, RowMinX + 2, RowMinX + 3);
+        __m128 PixelPx = _mm_sub_ps(_mm_cvtepi32_ps(PixelX), Originx_4x);
+
+        for (int32 XI = RowMinX; XI < RowMaxX; XI += 4) {
+
+#define Mi(a, i) (((uint32*)(&(a)))[i])
+
+            __m128 U = _mm_add_ps(_mm_mul_ps(PixelPx, nXAxisx_4x), PynX);
+            __m128 V = _mm_add_ps(_mm_mul_ps(PixelPx, nYAxisx_4x), PynY);
+
+            __m128i OriginalDest = _mm_load_si128((__m128i*)Pixel);
+            __m128i WriteMask = _mm_castps_si128(_mm_and_ps(
+                _mm_and_ps(_mm_cmpge_ps(U, Zero_4x), _mm_cmple_ps(U, One_4x)),
+                _mm_and_ps(_mm_cmpge_ps(V, Zero_4x), _mm_cmple_ps(V, One_4x))
+            ));
+            WriteMask = _mm_and_si128(WriteMask, _mm_and_si128(
+                _mm_cmpgt_epi32(PixelX, ClipMinX_4x),
+                _mm_cmpgt_epi32(ClipMaxX_4x, PixelX)
+            ));
+
+            U = _mm_min_ps(_mm_max_ps(U, Zero_4x), One_4x);
+            V = _mm_min_ps(_mm_max_ps(V, Zero_4x), One_4x);
+
+            __m128 TextureX = _mm_add_ps(_mm_mul_ps(U, WidthM2), Half_4x);
+            __m128 TextureY = _mm_add_ps(_mm_mul_ps(V, HeightM2), Half_4x);
+
+            __m128i TextureXFloored = _mm_cvttps_epi32(TextureX);
+            __m128i TextureYFloored = _mm_cvttps_epi32(TextureY);
+
+            __m128i fX = _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(TextureX, _mm_cvtepi32_ps(TextureXFloored)), One16_4x));
+            __m128i fY = _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(TextureY, _mm_cvtepi32_ps(TextureYFloored)), One16_4x));
+            __m128i ifX = _mm_sub_epi32(MaskFFFF_4x, fX);
+            __m128i ifY = _mm_sub_epi32(MaskFFFF_4x, fY);
+
+            __m128i l0 = _mm_mulhi_epu16(ifY, ifX);
+            __m128i l1 = _mm_mulhi_epu16(ifY, fX);
+            __m128i l2 = _mm_mulhi_epu16(fY, ifX);
+            __m128i l3 = _mm_mulhi_epu16(fY, fX);
+
+            __m128i SampleA, SampleB, SampleC, SampleD;
+            if (TextureTiled) {
+                __m128i ColumnA = TiledTexelColumnOffset(TextureXFloored);
+                __m128i ColumnB = TiledTexelColumnOffset(_mm_add_epi32(TextureXFloored, One_4xi));
+                __m128i RowA = TiledTexelRowOffset(TextureYFloored, TextureBlocksPerRow_4x);
+                __m128i RowC = TiledTexelRowOffset(_mm_add_epi32(TextureYFloored, One_4xi), TextureBlocksPerRow_4x);
+                __m128i FetchA = _mm_add_epi32(ColumnA, RowA);
+                __m128i FetchB = _mm_add_epi32(ColumnB, RowA);
+                __m128i FetchC = _mm_add_epi32(ColumnA, RowC);
+                __m128i FetchD = _mm_add_epi32(ColumnB, RowC);
+                SampleA = mmGatherTexels(TextureMemory, FetchA);
+                SampleB = mmGatherTexels(TextureMemory, FetchB);
+                SampleC = mmGatherTexels(TextureMemory, FetchC);
+                SampleD = mmGatherTexels(TextureMemory, FetchD);
+            } else {
+                // NOTE(sen) mul by BITMAP_BYTES_PER_PIXEL
+                __m128i FetchX = _mm_slli_epi32(TextureXFloored, 2);
+                __m128i FetchY = _mm_or_si128(
+                    _mm_mullo_epi16(TextureYFloored, TexturePitch_4x),
+                    _mm_slli_epi32(_mm_mulhi_epi16(TextureYFloored, TexturePitch_4x), 16)
+                );
+                __m128i Fetch_4x = _mm_add_epi32(FetchX, FetchY);
+
+                uint8* TexelPtr0 = TextureMemory + Mi(Fetch_4x, 0);
+                uint8* TexelPtr1 = TextureMemory + Mi(Fetch_4x, 1);
+                uint8* TexelPtr2 = TextureMemory + Mi(Fetch_4x, 2);
+                uint8* TexelPtr3 = TextureMemory + Mi(Fetch_4x, 3);
+
+                SampleA = _mm_setr_epi32(
+                    *(uint32*)TexelPtr0,
+                    *(uint32*)TexelPtr1,
+                    *(uint32*)TexelPtr2,
+                    *(uint32*)TexelPtr3
+                );
+                SampleB = _mm_setr_epi32(
+                    *(uint32*)(TexelPtr0 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr1 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr2 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr3 + BITMAP_BYTES_PER_PIXEL)
+                );
+                SampleC = _mm_setr_epi32(
+                    *(uint32*)(TexelPtr0 + TexturePitch),
+                    *(uint32*)(TexelPtr1 + TexturePitch),
+                    *(uint32*)(TexelPtr2 + TexturePitch),
+                    *(uint32*)(TexelPtr3 + TexturePitch)
+                );
+                SampleD = _mm_setr_epi32(
+                    *(uint32*)(TexelPtr0 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr1 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr2 + TexturePitch + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(TexelPtr3 + TexturePitch + BITMAP_BYTES_PER_PIXEL)
+                );
+            }
+
+            // NOTE(sen) Squaring 8-bit texels in 16-bit lanes is the sRGB->linear table's curve without the
+            // lookups, c^2 + (c^2 >> 7) stretches 255^2 out to (almost) 65535 to match the table's scale
+#define mmLinear16(Squared) _mm_add_epi16((Squared), _mm_srli_epi16((Squared), 7))
+            __m128i TexelArb = _mm_and_si128(SampleA, MaskFF00FF_4x);
+            __m128i TexelAag = _mm_srli_epi32(_mm_and_si128(SampleA, MaskFF00FF00_4x), 8);
+            TexelArb = mmLinear16(_mm_mullo_epi16(TexelArb, TexelArb));
+            __m128i TexelAa = _mm_mullo_epi16(_mm_srli_epi32(TexelAag, 16), Alpha8To16_4x);
+            TexelAag = mmLinear16(_mm_mullo_epi16(TexelAag, TexelAag));
+
+            __m128i TexelBrb = _mm_and_si128(SampleB, MaskFF00FF_4x);
+            __m128i TexelBag = _mm_srli_epi32(_mm_and_si128(SampleB, MaskFF00FF00_4x), 8);
+            TexelBrb = mmLinear16(_mm_mullo_epi16(TexelBrb, TexelBrb));
+            __m128i TexelBa = _mm_mullo_epi16(_mm_srli_epi32(TexelBag, 16), Alpha8To16_4x);
+            TexelBag = mmLinear16(_mm_mullo_epi16(TexelBag, TexelBag));
+
+            __m128i TexelCrb = _mm_and_si128(SampleC, MaskFF00FF_4x);
+            __m128i TexelCag = _mm_srli_epi32(_mm_and_si128(SampleC, MaskFF00FF00_4x), 8);
+            TexelCrb = mmLinear16(_mm_mullo_epi16(TexelCrb, TexelCrb));
+            __m128i TexelCa = _mm_mullo_epi16(_mm_srli_epi32(TexelCag, 16), Alpha8To16_4x);
+            TexelCag = mmLinear16(_mm_mullo_epi16(TexelCag, TexelCag));
+
+            __m128i TexelDrb = _mm_and_si128(SampleD, MaskFF00FF_4x);
+            __m128i TexelDag = _mm_srli_epi32(_mm_and_si128(SampleD, MaskFF00FF00_4x), 8);
+            TexelDrb = mmLinear16(_mm_mullo_epi16(TexelDrb, TexelDrb));
+            __m128i TexelDa = _mm_mullo_epi16(_mm_srli_epi32(TexelDag, 16), Alpha8To16_4x);
+            TexelDag = mmLinear16(_mm_mullo_epi16(TexelDag, TexelDag));
+
+            __m128i TexelAr = _mm_srli_epi32(TexelArb, 16);
+            __m128i TexelAg = _mm_and_si128(TexelAag, MaskFFFF_4x);
+            __m128i TexelAb = _mm_and_si128(TexelArb, MaskFFFF_4x);
+            __m128i TexelBr = _mm_srli_epi32(TexelBrb, 16);
+            __m128i TexelBg = _mm_and_si128(TexelBag, MaskFFFF_4x);
+            __m128i TexelBb = _mm_and_si128(TexelBrb, MaskFFFF_4x);
+            __m128i TexelCr = _mm_srli_epi32(TexelCrb, 16);
+            __m128i TexelCg = _mm_and_si128(TexelCag, MaskFFFF_4x);
+            __m128i TexelCb = _mm_and_si128(TexelCrb, MaskFFFF_4x);
+            __m128i TexelDr = _mm_srli_epi32(TexelDrb, 16);
+            __m128i TexelDg = _mm_and_si128(TexelDag, MaskFFFF_4x);
+            __m128i TexelDb = _mm_and_si128(TexelDrb, MaskFFFF_4x);
+
+#define mmBilerp16(A, B, C, D) _mm_add_epi32( \
+    _mm_add_epi32(_mm_mulhi_epu16(l0, A), _mm_mulhi_epu16(l1, B)), \
+    _mm_add_epi32(_mm_mulhi_epu16(l2, C), _mm_mulhi_epu16(l3, D)))
+
+            __m128i Texelr = _mm_mulhi_epu16(mmBilerp16(TexelAr, TexelBr, TexelCr, TexelDr), Colorr_4x);
+            __m128i Texelg = _mm_mulhi_epu16(mmBilerp16(TexelAg, TexelBg, TexelCg, TexelDg), Colorg_4x);
+            __m128i Texelb = _mm_mulhi_epu16(mmBilerp16(TexelAb, TexelBb, TexelCb, TexelDb), Colorb_4x);
+            __m128i Texela = _mm_mulhi_epu16(mmBilerp16(TexelAa, TexelBa, TexelCa, TexelDa), Colora_4x);
+
+            __m128i Blendedr, Blendedg, Blendedb, Blendeda;
+            if (XI >= OpaqueMinX && XI + 4 <= OpaqueMaxX) {
+                // NOTE(sen) Every tap has full alpha, none of the destination shows through
+                Blendedr = Texelr;
+                Blendedg = Texelg;
+                Blendedb = Texelb;
+                Blendeda = Texela;
+            } else {
+                __m128i Destrb = _mm_and_si128(OriginalDest, MaskFF00FF_4x);
+                __m128i Destg = _mm_and_si128(_mm_srli_epi32(OriginalDest, 8), MaskFF_4x);
+                Destrb = mmLinear16(_mm_mullo_epi16(Destrb, Destrb));
+                Destg = mmLinear16(_mm_mullo_epi16(Destg, Destg));
+                __m128i Destr = _mm_srli_epi32(Destrb, 16);
+                __m128i Destb = _mm_and_si128(Destrb, MaskFFFF_4x);
+                __m128i Desta = _mm_mullo_epi16(_mm_srli_epi32(OriginalDest, 24), Alpha8To16_4x);
+
+                __m128i InvTexelA = _mm_sub_epi32(MaskFFFF_4x, Texela);
+                Blendedr = _mm_adds_epu16(_mm_mulhi_epu16(InvTexelA, Destr), Texelr);
+                Blendedg = _mm_adds_epu16(_mm_mulhi_epu16(InvTexelA, Destg), Texelg);
+                Blendedb = _mm_adds_epu16(_mm_mulhi_epu16(InvTexelA, Destb), Texelb);
+                Blendeda = _mm_adds_epu16(_mm_mulhi_epu16(InvTexelA, Desta), Texela);
+            }
+
+            __m128i Indexr = _mm_srli_epi32(Blendedr, 4);
+            __m128i Indexg = _mm_srli_epi32(Blendedg, 4);
+            __m128i Indexb = _mm_srli_epi32(Blendedb, 4);
+            __m128i Out = _mm_setr_epi32(
+                (Linear12ToSRGB8[Mi(Indexr, 0)] << 16) | (Linear12ToSRGB8[Mi(Indexg, 0)] << 8) | Linear12ToSRGB8[Mi(Indexb, 0)],
+                (Linear12ToSRGB8[Mi(Indexr, 1)] << 16) | (Linear12ToSRGB8[Mi(Indexg, 1)] << 8) | Linear12ToSRGB8[Mi(Indexb, 1)],
+                (Linear12ToSRGB8[Mi(Indexr, 2)] << 16) | (Linear12ToSRGB8[Mi(Indexg, 2)] << 8) | Linear12ToSRGB8[Mi(Indexb, 2)],
+                (Linear12ToSRGB8[Mi(Indexr, 3)] << 16) | (Linear12ToSRGB8[Mi(Indexg, 3)] << 8) | Linear12ToSRGB8[Mi(Indexb, 3)]
+            );
+            Out = _mm_or_si128(Out, _mm_slli_epi32(_mm_srli_epi32(Blendeda, 8), 24));
+
+            __m128i MaskedOut = _mm_or_si128(
+                _mm_and_si128(WriteMask, Out),
+                _mm_andnot_si128(WriteMask, OriginalDest)
+            );
+            _mm_store_si128((__m128i*)Pixel, MaskedOut);
+
+            Pixel += 4;
+            PixelPx = _mm_add_ps(PixelPx, Four_4x);
+            PixelX = _mm_add_epi32(PixelX, Fouri_4x);
+        }
+        Row += RowAdvance;
+    }
+}
+
+/// One 8-bit channel of 4 bilinear samples. Squared takes color channels to linear the same way
+/// the other kernels do (0 - 255^2), normals and alpha are filtered as they are.
+FORCE_INLINE internal __m128 mmBilinearChannel(
+    __m128i SampleA, __m128i SampleB, __m128i SampleC, __m128i SampleD, int32 Shift, bool32 Squared,
+    __m128 l0, __m128 l1, __m128 l2, __m128 l3
+) {
+    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
+    __m128 ChannelA = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleA, Shift), MaskFF_4x));
+    __m128 ChannelB = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleB, Shift), MaskFF_4x));
+    __m128 ChannelC = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleC, Shift), MaskFF_4x));
+    __m128 ChannelD = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleD, Shift), MaskFF_4x));
+    if (Squared) {
+        ChannelA = mmSquare(ChannelA);
+        ChannelB = mmSquare(ChannelB);
+        ChannelC = mmSquare(ChannelC);
+        ChannelD = mmSquare(ChannelD);
+    }
+    __m128 Result = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(l0, ChannelA), _mm_mul_ps(l1, ChannelB)),
+        _mm_add_ps(_mm_mul_ps(l2, ChannelC), _mm_mul_ps(l3, ChannelD))
+    );
+    return Result;
+}
+
+// NOTE(sen) Lanes that don't take any light still fetch, from here when their map is missing
+global_variable uint32 GlobalNullEnvironmentTexels[4];
+
+/// DrawRectangleQuickly with the lighting of DrawRectangleSlowly. The normal map is turned by the
+/// quad's axes and the view ray bounced off it into the Top or Bottom map, at the LOD the normal's
+/// roughness (its alpha) picks. Middle isn't sampled, same as there. Lit sprites don't have mips,
+/// the normal map has to match the texture texel for texel.
+internal void DrawRectangleLit(
+    loaded_bitmap* Buffer,
+    v2 Origin, v2 XAxis, v2 YAxis,
+    v4 Color, loaded_bitmap* Texture, loaded_bitmap* NormalMap,
+    environment_map* Top, environment_map* Middle, environment_map* Bottom,
+    real32 PixelsToMeters,
+    rectangle2i ClipRect, bool32 Even
+) {
+    TIMED_FUNCTION();
+
+    Assert(!Texture->Tiled && !NormalMap->Tiled);
+    Assert(NormalMap->Width == Texture->Width && NormalMap->Height == Texture->Height);
+    Assert(NormalMap->Pitch == Texture->Pitch);
+
+    Color.rgb *= Color.a;
+
+    rectangle2i FillRect = Intersect(GetQuadScreenBounds(Origin, XAxis, YAxis), ClipRect);
+
+    // NOTE(sen) Alternating scanlines
+    if (!Even == (FillRect.MinY & 1)) {
+        FillRect.MinY += 1;
+    }
+
+    if (!HasArea(FillRect)) {
+        return;
+    }
+
+    __m128i ClipMinX_4x = _mm_set1_epi32(FillRect.MinX - 1);
+    __m128i ClipMaxX_4x = _mm_set1_epi32(FillRect.MaxX);
+    FillRect.MinX = FillRect.MinX & ~3;
+    FillRect.MaxX = (FillRect.MaxX + 3) & ~3;
+
+    real32 XAxisLength = Length(XAxis);
+    real32 YAxisLength = Length(YAxis);
+
+    v2 NxAxis = (YAxisLength / XAxisLength) * XAxis;
+    v2 NyAxis = (XAxisLength / YAxisLength) * YAxis;
+    real32 NzScale = 0.5f * (XAxisLength + YAxisLength);
+
+    real32 InvXAxisLengthSq = 1 / LengthSq(XAxis);
+    real32 InvYAxisLengthSq = 1 / LengthSq(YAxis);
+
+    v2 nXAxis = XAxis * InvXAxisLengthSq;
+    v2 nYAxis = YAxis * InvYAxisLengthSq;
+
+    real32 InvWidthMax = 1.0f / (real32)(Buffer->Width - 1);
+    real32 InvHeightMax = 1.0f / (real32)(Buffer->Height - 1);
+
+    real32 OriginZ = 0.0f;
+    real32 OriginY = (Origin + 0.5f * XAxis + 0.5f * YAxis).y;
+    real32 FixedCastY = InvHeightMax * OriginY;
+
+    // NOTE(sen) Each lane picks its map and LOD, Bottom's come first
+    environment_map* FarMaps[2] = {Bottom, Top};
+    uint8* LODMemory[2 * ArrayCount(Top->LOD)];
+    int32 LODPitch[2 * ArrayCount(Top->LOD)];
+    real32 LODWidthM2[2 * ArrayCount(Top->LOD)];
+    real32 LODHeightM2[2 * ArrayCount(Top->LOD)];
+    for (uint32 MapIndex = 0; MapIndex < ArrayCount(FarMaps); ++MapIndex) {
+        for (uint32 LODIndex = 0; LODIndex < ArrayCount(Top->LOD); ++LODIndex) {
+            uint32 Index = MapIndex * ArrayCount(Top->LOD) + LODIndex;
+            if (FarMaps[MapIndex]) {
+                loaded_bitmap* LOD = FarMaps[MapIndex]->LOD + LODIndex;
+                LODMemory[Index] = (uint8*)LOD->Memory;
+                LODPitch[Index] = LOD->Pitch;
+                LODWidthM2[Index] = (real32)(LOD->Width - 2);
+                LODHeightM2[Index] = (real32)(LOD->Height - 2);
+            } else {
+                LODMemory[Index] = (uint8*)GlobalNullEnvironmentTexels;
+                LODPitch[Index] = 2 * BITMAP_BYTES_PER_PIXEL;
+                LODWidthM2[Index] = 0.0f;
+                LODHeightM2[Index] = 0.0f;
+            }
+        }
+    }
+    __m128 HasBottom_4x = _mm_castsi128_ps(_mm_set1_epi32(Bottom ? -1 : 0));
+    __m128 HasTop_4x = _mm_castsi128_ps(_mm_set1_epi32(Top ? -1 : 0));
+    __m128i TopLODIndex_4x = _mm_set1_epi32(ArrayCount(Top->LOD));
+    __m128 MaxLOD_4x = _mm_set1_ps((real32)(ArrayCount(Top->LOD) - 1));
+
+    __m128 Half_4x = _mm_set1_ps(0.5f);
+    __m128 One_4x = _mm_set1_ps(1.0f);
+    __m128 Two_4x = _mm_set1_ps(2.0f);
+    __m128 Zero_4x = _mm_set1_ps(0.0f);
+    __m128 Four_4x = _mm_set1_ps(4.0f);
+    __m128 Inv255_4x = _mm_set1_ps(1.0f / 255.0f);
+    __m128 Two255_4x = _mm_set1_ps(2.0f / 255.0f);
+    __m128 SignMask_4x = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+    __m128 MinLengthSq_4x = _mm_set1_ps(1e-8f);
+    __m128i Fouri_4x = _mm_set1_epi32(4);
+    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
+    __m128 MaxColorValue_4x = _mm_set1_ps(255.0f * 255.0f);
+    __m128 UVsPerMeter_4x = _mm_set1_ps(0.1f);
+
+    __m128 Colorr_4x = _mm_set1_ps(Color.r);
+    __m128 Colorg_4x = _mm_set1_ps(Color.g);
+    __m128 Colorb_4x = _mm_set1_ps(Color.b);
+    __m128 Colora_4x = _mm_set1_ps(Color.a);
+
+    __m128 nXAxisx_4x = _mm_set1_ps(nXAxis.x);
+    __m128 nXAxisy_4x = _mm_set1_ps(nXAxis.y);
+    __m128 nYAxisx_4x = _mm_set1_ps(nYAxis.x);
+    __m128 nYAxisy_4x = _mm_set1_ps(nYAxis.y);
+
+    __m128 NxAxisx_4x = _mm_set1_ps(NxAxis.x);
+    __m128 NxAxisy_4x = _mm_set1_ps(NxAxis.y);
+    __m128 NyAxisx_4x = _mm_set1_ps(NyAxis.x);
+    __m128 NyAxisy_4x = _mm_set1_ps(NyAxis.y);
+    __m128 NzScale_4x = _mm_set1_ps(NzScale);
+
+    __m128 Originx_4x = _mm_set1_ps(Origin.x);
+    __m128 Originy_4x = _mm_set1_ps(Origin.y);
+    __m128 InvWidthMax_4x = _mm_set1_ps(InvWidthMax);
+    __m128 ScreenSpaceV_4x = _mm_set1_ps(FixedCastY);
+
+    __m128 WidthM2 = _mm_set1_ps((real32)Texture->Width - 2);
+    __m128 HeightM2 = _mm_set1_ps((real32)Texture->Height - 2);
+
+    uint8* TextureMemory = (uint8*)Texture->Memory;
+    uint8* NormalMemory = (uint8*)NormalMap->Memory;
+    int32 TexturePitch = Texture->Pitch;
+    __m128i TexturePitch_4x = _mm_set1_epi32(TexturePitch);
+
+    int32 MaxY = FillRect.MaxY;
+    int32 MinY = FillRect.MinY;
+    int32 MaxX = FillRect.MaxX;
+    int32 MinX = FillRect.MinX;
+
+    TIMED_BLOCK(PixelFillLit, GetClampedRectArea(FillRect) / 2);
+    for (int32 Y = MinY; Y < MaxY; Y += 2) {
+
+        quad_row_span QuadSpan = GetQuadRowSpan(Origin, nXAxis, nYAxis, MinX, MaxX, Y);
+        int32 RowMinX = Maximum(MinX, QuadSpan.MinX & ~3);
+        int32 RowMaxX = Minimum(MaxX, (QuadSpan.MaxX + 3) & ~3);
+
+        real32 Pz = OriginZ + PixelsToMeters * ((real32)Y - OriginY);
+        __m128 BottomDistance_4x = _mm_set1_ps(Bottom ? Bottom->Pz - Pz : 0.0f);
+        __m128 TopDistance_4x = _mm_set1_ps(Top ? Top->Pz - Pz : 0.0f);
+
+        uint32* Pixel = (uint32*)((uint8*)Buffer->Memory + Y * Buffer->Pitch) + RowMinX;
+        __m128 PixelPy = _mm_sub_ps(_mm_set1_ps((real32)Y), Originy_4x);
+        __m128 PynX = _mm_mul_ps(PixelPy, nXAxisy_4x);
+        __m128 PynY = _mm_mul_ps(PixelPy, nYAxisy_4x);
+
+        __m128i PixelX = _mm_setr_epi32(RowMinX, RowMinX + 1, RowMinX + 2, RowMinX + 3);
+        __m128 PixelXf = _mm_cvtepi32_ps(PixelX);
+
+        for (int32 XI = RowMinX; XI < RowMaxX; XI += 4, Pixel += 4,
+            PixelX = _mm_add_epi32(PixelX, Fouri_4x), PixelXf = _mm_add_ps(PixelXf, Four_4x)) {
+
+            __m128 PixelPx = _mm_sub_ps(PixelXf, Originx_4x);
+            __m128 U = _mm_add_ps(_mm_mul_ps(PixelPx, nXAxisx_4x), PynX);
+            __m128 V = _mm_add_ps(_mm_mul_ps(PixelPx, nYAxisx_4x), PynY);
+
+            __m128i WriteMask = _mm_castps_si128(_mm_and_ps(
+                _mm_and_ps(_mm_cmpge_ps(U, Zero_4x), _mm_cmple_ps(U, One_4x)),
+                _mm_and_ps(_mm_cmpge_ps(V, Zero_4x), _mm_cmple_ps(V, One_4x))
+            ));
+            WriteMask = _mm_and_si128(WriteMask, _mm_and_si128(
+                _mm_cmpgt_epi32(PixelX, ClipMinX_4x),
+                _mm_cmpgt_epi32(ClipMaxX_4x, PixelX)
+            ));
+            if (_mm_movemask_epi8(WriteMask) == 0) {
+                continue;
+            }
+
+            U = _mm_min_ps(_mm_max_ps(U, Zero_4x), One_4x);
+            V = _mm_min_ps(_mm_max_ps(V, Zero_4x), One_4x);
 
-            __m128 TexelDr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleD, 16), MaskFF_4x));
-            __m128 TexelDg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleD, 8), MaskFF_4x));
-            __m128 TexelDb = _mm_cvtepi32_ps(_mm_and_si128(SampleD, MaskFF_4x));
-            __m128 TexelDa = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(SampleD, 24), MaskFF_4x));
+            __m128 TextureX = _mm_add_ps(_mm_mul_ps(U, WidthM2), Half_4x);
+            __m128 TextureY = _mm_add_ps(_mm_mul_ps(V, HeightM2), Half_4x);
 
-            TexelAr = mmSquare(TexelAr);
-            TexelAg = mmSquare(TexelAg);
-            TexelAb = mmSquare(TexelAb);
-            TexelBr = mmSquare(TexelBr);
-            TexelBg = mmSquare(TexelBg);
-            TexelBb = mmSquare(TexelBb);
-            TexelCr = mmSquare(TexelCr);
-            TexelCg = mmSquare(TexelCg);
-            TexelCb = mmSquare(TexelCb);
-            TexelDr = mmSquare(TexelDr);
-            TexelDg = mmSquare(TexelDg);
-            TexelDb = mmSquare(TexelDb);
-#endif
+            __m128i TextureXFloored = _mm_cvttps_epi32(TextureX);
+            __m128i TextureYFloored = _mm_cvttps_epi32(TextureY);
 
-            __m128 Destr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 16), MaskFF_4x));
-            __m128 Destg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 8), MaskFF_4x));
-            __m128 Destb = _mm_cvtepi32_ps(_mm_and_si128(OriginalDest, MaskFF_4x));
-            __m128 Desta = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 24), MaskFF_4x));
+            __m128 TextureXf = _mm_sub_ps(TextureX, _mm_cvtepi32_ps(TextureXFloored));
+            __m128 TextureYf = _mm_sub_ps(TextureY, _mm_cvtepi32_ps(TextureYFloored));
+
+            // NOTE(sen) mul by BITMAP_BYTES_PER_PIXEL
+            __m128i FetchX = _mm_slli_epi32(TextureXFloored, 2);
+            __m128i FetchY = _mm_or_si128(
+                _mm_mullo_epi16(TextureYFloored, TexturePitch_4x),
+                _mm_slli_epi32(_mm_mulhi_epi16(TextureYFloored, TexturePitch_4x), 16)
+            );
+            __m128i Fetch = _mm_add_epi32(FetchX, FetchY);
 
             __m128 ifx = _mm_sub_ps(One_4x, TextureXf);
             __m128 ify = _mm_sub_ps(One_4x, TextureYf);
@@ -1013,10 +3171,139 @@ internal void DrawRectangleQuickly(
             __m128 l2 = _mm_mul_ps(TextureYf, ifx);
             __m128 l3 = _mm_mul_ps(TextureYf, TextureXf);
 
-            __m128 Texelr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAr), _mm_mul_ps(l1, TexelBr)), _mm_add_ps(_mm_mul_ps(l2, TexelCr), _mm_mul_ps(l3, TexelDr)));
-            __m128 Texelg = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAg), _mm_mul_ps(l1, TexelBg)), _mm_add_ps(_mm_mul_ps(l2, TexelCg), _mm_mul_ps(l3, TexelDg)));
-            __m128 Texelb = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAb), _mm_mul_ps(l1, TexelBb)), _mm_add_ps(_mm_mul_ps(l2, TexelCb), _mm_mul_ps(l3, TexelDb)));
-            __m128 Texela = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, TexelAa), _mm_mul_ps(l1, TexelBa)), _mm_add_ps(_mm_mul_ps(l2, TexelCa), _mm_mul_ps(l3, TexelDa)));
+            __m128i SampleA = mmGatherTexels(TextureMemory, Fetch);
+            __m128i SampleB = mmGatherTexels(TextureMemory + BITMAP_BYTES_PER_PIXEL, Fetch);
+            __m128i SampleC = mmGatherTexels(TextureMemory + TexturePitch, Fetch);
+            __m128i SampleD = mmGatherTexels(TextureMemory + TexturePitch + BITMAP_BYTES_PER_PIXEL, Fetch);
+
+            __m128 Texela = mmBilinearChannel(SampleA, SampleB, SampleC, SampleD, 24, false, l0, l1, l2, l3);
+
+            // NOTE(sen) Nothing to light or draw, lit sprites are mostly transparent around the edges
+            __m128 Visible = _mm_and_ps(_mm_cmpgt_ps(Texela, Zero_4x), _mm_castsi128_ps(WriteMask));
+            if (_mm_movemask_ps(Visible) == 0) {
+                continue;
+            }
+
+            __m128 Texelr = mmBilinearChannel(SampleA, SampleB, SampleC, SampleD, 16, true, l0, l1, l2, l3);
+            __m128 Texelg = mmBilinearChannel(SampleA, SampleB, SampleC, SampleD, 8, true, l0, l1, l2, l3);
+            __m128 Texelb = mmBilinearChannel(SampleA, SampleB, SampleC, SampleD, 0, true, l0, l1, l2, l3);
+
+            __m128i NormalA = mmGatherTexels(NormalMemory, Fetch);
+            __m128i NormalB = mmGatherTexels(NormalMemory + BITMAP_BYTES_PER_PIXEL, Fetch);
+            __m128i NormalC = mmGatherTexels(NormalMemory + TexturePitch, Fetch);
+            __m128i NormalD = mmGatherTexels(NormalMemory + TexturePitch + BITMAP_BYTES_PER_PIXEL, Fetch);
+
+            __m128 Normalx = mmBilinearChannel(NormalA, NormalB, NormalC, NormalD, 16, false, l0, l1, l2, l3);
+            __m128 Normaly = mmBilinearChannel(NormalA, NormalB, NormalC, NormalD, 8, false, l0, l1, l2, l3);
+            __m128 Normalz = mmBilinearChannel(NormalA, NormalB, NormalC, NormalD, 0, false, l0, l1, l2, l3);
+            __m128 Roughness = mmBilinearChannel(NormalA, NormalB, NormalC, NormalD, 24, false, l0, l1, l2, l3);
+
+            // NOTE(sen) UnscaleAndBiasNormal
+            Normalx = _mm_sub_ps(_mm_mul_ps(Two255_4x, Normalx), One_4x);
+            Normaly = _mm_sub_ps(_mm_mul_ps(Two255_4x, Normaly), One_4x);
+            Normalz = _mm_sub_ps(_mm_mul_ps(Two255_4x, Normalz), One_4x);
+            Roughness = _mm_mul_ps(Inv255_4x, Roughness);
+
+            __m128 ScreenNormalx = _mm_add_ps(_mm_mul_ps(Normalx, NxAxisx_4x), _mm_mul_ps(Normaly, NyAxisx_4x));
+            __m128 ScreenNormaly = _mm_add_ps(_mm_mul_ps(Normalx, NxAxisy_4x), _mm_mul_ps(Normaly, NyAxisy_4x));
+            __m128 ScreenNormalz = _mm_mul_ps(Normalz, NzScale_4x);
+
+            __m128 NormalLengthSq = _mm_add_ps(
+                _mm_add_ps(mmSquare(ScreenNormalx), mmSquare(ScreenNormaly)), mmSquare(ScreenNormalz)
+            );
+            __m128 InvNormalLength = _mm_rsqrt_ps(_mm_max_ps(NormalLengthSq, MinLengthSq_4x));
+            Normalx = _mm_mul_ps(ScreenNormalx, InvNormalLength);
+            Normaly = _mm_mul_ps(ScreenNormaly, InvNormalLength);
+            Normalz = _mm_mul_ps(ScreenNormalz, InvNormalLength);
+
+            // NOTE(sen) The eye vector is (0, 0, 1), bounced and flipped in z
+            __m128 TwoNz = _mm_mul_ps(Two_4x, Normalz);
+            __m128 Bouncex = _mm_mul_ps(TwoNz, Normalx);
+            __m128 Bouncey = _mm_mul_ps(TwoNz, Normaly);
+            __m128 Bouncez = _mm_sub_ps(One_4x, _mm_mul_ps(TwoNz, Normalz));
+
+            // NOTE(sen) Mostly up picks Top, mostly down Bottom, the weight goes from 0 at 0.5 to 1 at 1
+            __m128 AbsBouncey = _mm_andnot_ps(SignMask_4x, Bouncey);
+            __m128 TopMask = _mm_cmpgt_ps(Bouncey, Zero_4x);
+            __m128 LitMask = _mm_and_ps(
+                _mm_cmpgt_ps(AbsBouncey, Half_4x),
+                _mm_or_ps(_mm_and_ps(TopMask, HasTop_4x), _mm_andnot_ps(TopMask, HasBottom_4x))
+            );
+            LitMask = _mm_and_ps(LitMask, Visible);
+
+            if (_mm_movemask_ps(LitMask)) {
+                __m128 tFarMap = _mm_sub_ps(_mm_mul_ps(Two_4x, AbsBouncey), One_4x);
+                tFarMap = _mm_and_ps(LitMask, mmSquare(tFarMap));
+
+                // NOTE(sen) SampleEnvironmentMap, unlit lanes get a harmless ray
+                __m128 DistanceFromMapInZ = _mm_or_ps(
+                    _mm_and_ps(TopMask, TopDistance_4x), _mm_andnot_ps(TopMask, BottomDistance_4x)
+                );
+                __m128 SafeBouncey = _mm_or_ps(_mm_and_ps(LitMask, Bouncey), _mm_andnot_ps(LitMask, One_4x));
+                __m128 Coef = _mm_mul_ps(_mm_mul_ps(UVsPerMeter_4x, DistanceFromMapInZ), _mm_rcp_ps(SafeBouncey));
+                __m128 EnvU = _mm_add_ps(_mm_mul_ps(PixelXf, InvWidthMax_4x), _mm_mul_ps(Coef, Bouncex));
+                __m128 EnvV = _mm_add_ps(ScreenSpaceV_4x, _mm_mul_ps(Coef, Bouncez));
+                EnvU = _mm_min_ps(_mm_max_ps(EnvU, Zero_4x), One_4x);
+                EnvV = _mm_min_ps(_mm_max_ps(EnvV, Zero_4x), One_4x);
+
+                __m128 LOD = _mm_min_ps(_mm_max_ps(_mm_mul_ps(Roughness, MaxLOD_4x), Zero_4x), MaxLOD_4x);
+                __m128i LODIndex = _mm_add_epi32(
+                    _mm_cvtps_epi32(LOD), _mm_and_si128(_mm_castps_si128(TopMask), TopLODIndex_4x)
+                );
+                uint32 LODIndex0 = Mi(LODIndex, 0);
+                uint32 LODIndex1 = Mi(LODIndex, 1);
+                uint32 LODIndex2 = Mi(LODIndex, 2);
+                uint32 LODIndex3 = Mi(LODIndex, 3);
+
+                __m128 MapX = _mm_mul_ps(EnvU, _mm_setr_ps(
+                    LODWidthM2[LODIndex0], LODWidthM2[LODIndex1], LODWidthM2[LODIndex2], LODWidthM2[LODIndex3]
+                ));
+                __m128 MapY = _mm_mul_ps(EnvV, _mm_setr_ps(
+                    LODHeightM2[LODIndex0], LODHeightM2[LODIndex1], LODHeightM2[LODIndex2], LODHeightM2[LODIndex3]
+                ));
+                __m128i MapXFloored = _mm_cvttps_epi32(MapX);
+                __m128i MapYFloored = _mm_cvttps_epi32(MapY);
+                __m128 MapXf = _mm_sub_ps(MapX, _mm_cvtepi32_ps(MapXFloored));
+                __m128 MapYf = _mm_sub_ps(MapY, _mm_cvtepi32_ps(MapYFloored));
+
+                uint8* EnvPtr0 = LODMemory[LODIndex0] + Mi(MapYFloored, 0) * LODPitch[LODIndex0] + Mi(MapXFloored, 0) * BITMAP_BYTES_PER_PIXEL;
+                uint8* EnvPtr1 = LODMemory[LODIndex1] + Mi(MapYFloored, 1) * LODPitch[LODIndex1] + Mi(MapXFloored, 1) * BITMAP_BYTES_PER_PIXEL;
+                uint8* EnvPtr2 = LODMemory[LODIndex2] + Mi(MapYFloored, 2) * LODPitch[LODIndex2] + Mi(MapXFloored, 2) * BITMAP_BYTES_PER_PIXEL;
+                uint8* EnvPtr3 = LODMemory[LODIndex3] + Mi(MapYFloored, 3) * LODPitch[LODIndex3] + Mi(MapXFloored, 3) * BITMAP_BYTES_PER_PIXEL;
+
+                __m128i EnvA = _mm_setr_epi32(*(uint32*)EnvPtr0, *(uint32*)EnvPtr1, *(uint32*)EnvPtr2, *(uint32*)EnvPtr3);
+                __m128i EnvB = _mm_setr_epi32(
+                    *(uint32*)(EnvPtr0 + BITMAP_BYTES_PER_PIXEL), *(uint32*)(EnvPtr1 + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(EnvPtr2 + BITMAP_BYTES_PER_PIXEL), *(uint32*)(EnvPtr3 + BITMAP_BYTES_PER_PIXEL)
+                );
+                __m128i EnvC = _mm_setr_epi32(
+                    *(uint32*)(EnvPtr0 + LODPitch[LODIndex0]), *(uint32*)(EnvPtr1 + LODPitch[LODIndex1]),
+                    *(uint32*)(EnvPtr2 + LODPitch[LODIndex2]), *(uint32*)(EnvPtr3 + LODPitch[LODIndex3])
+                );
+                __m128i EnvD = _mm_setr_epi32(
+                    *(uint32*)(EnvPtr0 + LODPitch[LODIndex0] + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(EnvPtr1 + LODPitch[LODIndex1] + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(EnvPtr2 + LODPitch[LODIndex2] + BITMAP_BYTES_PER_PIXEL),
+                    *(uint32*)(EnvPtr3 + LODPitch[LODIndex3] + BITMAP_BYTES_PER_PIXEL)
+                );
+
+                __m128 iMapXf = _mm_sub_ps(One_4x, MapXf);
+                __m128 iMapYf = _mm_sub_ps(One_4x, MapYf);
+                __m128 e0 = _mm_mul_ps(iMapYf, iMapXf);
+                __m128 e1 = _mm_mul_ps(iMapYf, MapXf);
+                __m128 e2 = _mm_mul_ps(MapYf, iMapXf);
+                __m128 e3 = _mm_mul_ps(MapYf, MapXf);
+
+                __m128 Lightr = mmBilinearChannel(EnvA, EnvB, EnvC, EnvD, 16, true, e0, e1, e2, e3);
+                __m128 Lightg = mmBilinearChannel(EnvA, EnvB, EnvC, EnvD, 8, true, e0, e1, e2, e3);
+                __m128 Lightb = mmBilinearChannel(EnvA, EnvB, EnvC, EnvD, 0, true, e0, e1, e2, e3);
+
+                // NOTE(sen) Texel.rgb += Texel.a * LightColor, with alpha in 0-255
+                __m128 LightScale = _mm_mul_ps(_mm_mul_ps(Texela, Inv255_4x), tFarMap);
+                Texelr = _mm_add_ps(Texelr, _mm_mul_ps(LightScale, Lightr));
+                Texelg = _mm_add_ps(Texelg, _mm_mul_ps(LightScale, Lightg));
+                Texelb = _mm_add_ps(Texelb, _mm_mul_ps(LightScale, Lightb));
+            }
 
             Texelr = _mm_mul_ps(Texelr, Colorr_4x);
             Texelg = _mm_mul_ps(Texelg, Colorg_4x);
@@ -1027,6 +3314,13 @@ internal void DrawRectangleQuickly(
             Texelg = _mm_min_ps(_mm_max_ps(Texelg, Zero_4x), MaxColorValue_4x);
             Texelb = _mm_min_ps(_mm_max_ps(Texelb, Zero_4x), MaxColorValue_4x);
 
+            __m128i OriginalDest = _mm_load_si128((__m128i*)Pixel);
+
+            __m128 Destr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 16), MaskFF_4x));
+            __m128 Destg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 8), MaskFF_4x));
+            __m128 Destb = _mm_cvtepi32_ps(_mm_and_si128(OriginalDest, MaskFF_4x));
+            __m128 Desta = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 24), MaskFF_4x));
+
             Destr = mmSquare(Destr);
             Destg = mmSquare(Destg);
             Destb = mmSquare(Destb);
@@ -1050,29 +3344,11 @@ internal void DrawRectangleQuickly(
                 _mm_or_si128(_mm_slli_epi32(Intr, 16), _mm_slli_epi32(Intg, 8)),
                 _mm_or_si128(Intb, _mm_slli_epi32(Inta, 24))
             );
-#else
-            __m128i Out = _mm_or_si128(TextureXFloored, TextureYFloored);
-#endif
-            __m128i MaskedOut = _mm_or_si128(
-                _mm_and_si128(WriteMask, Out),
-                _mm_andnot_si128(WriteMask, OriginalDest)
-            );
+            __m128i MaskedOut = _mm_or_si128(_mm_and_si128(WriteMask, Out), _mm_andnot_si128(WriteMask, OriginalDest));
 
             _mm_store_si128((__m128i*)Pixel, MaskedOut);
-
-            Pixel += 4;
-            ClipMask = _mm_set1_epi32(0xFFFFFFFF);
-
-            if (XI + 8 >= MaxX) {
-                ClipMask = EndClipMask;
-            }
-
-            IACA_VC64_END;
         }
-        Row += RowAdvance;
     }
-    //END_TIMED_BLOCK_COUNTED(ProcessPixel, GetClampedRectArea(FillRect) / 2);
-    //END_TIMED_BLOCK(DrawRectangleQuickly);
 }
 
 internal void DrawBitmap(
@@ -1151,40 +3427,75 @@ internal void DrawBitmap(
     }
 }
 
-internal void ChangeSaturation(loaded_bitmap* Buffer, real32 Level) {
+/// Lerps each pixel between its grey and itself in squared space, only inside ClipRect on Even/Odd rows
+internal void ChangeSaturation(loaded_bitmap* Buffer, real32 Level, rectangle2i ClipRect, bool32 Even) {
+    TIMED_FUNCTION();
 
-    uint8* DestRow = (uint8*)Buffer->Memory;
+    // NOTE(sen) sqrt(x^2) gives back x, nothing to do
+    if (Level == 1.0f) {
+        return;
+    }
 
-    for (int32 Y = 0; Y < Buffer->Height; ++Y) {
-        uint32* Dest = (uint32*)DestRow;
+    rectangle2i FillRect = GetFillRect(V2(0, 0), V2i(Buffer->Width, Buffer->Height), ClipRect, Even);
+    if (!HasArea(FillRect)) {
+        return;
+    }
 
-        for (int32 X = 0; X < Buffer->Width; ++X) {
+    __m128i ClipMinX_4x = _mm_set1_epi32(FillRect.MinX - 1);
+    __m128i ClipMaxX_4x = _mm_set1_epi32(FillRect.MaxX);
+    int32 MinX = FillRect.MinX & ~3;
+    int32 MaxX = (FillRect.MaxX + 3) & ~3;
 
-            v4 Destv4 = V4(
-                (real32)((*Dest >> 16) & 0xFF),
-                (real32)((*Dest >> 8) & 0xFF),
-                (real32)((*Dest) & 0xFF),
-                (real32)((*Dest >> 24) & 0xFF)
+    __m128 Level_4x = _mm_set1_ps(Level);
+    __m128 OneThird_4x = _mm_set1_ps(1.0f / 3.0f);
+    __m128 Zero_4x = _mm_set1_ps(0.0f);
+    __m128 MaxColorValue_4x = _mm_set1_ps(255.0f * 255.0f);
+    __m128i MaskFF_4x = _mm_set1_epi32(0xFF);
+    __m128i MaskFF000000_4x = _mm_set1_epi32(0xFF000000);
+    __m128i Four_4x = _mm_set1_epi32(4);
+
+    uint8* Row = (uint8*)Buffer->Memory + FillRect.MinY * Buffer->Pitch + MinX * BITMAP_BYTES_PER_PIXEL;
+    for (int32 Y = FillRect.MinY; Y < FillRect.MaxY; Y += 2) {
+        uint32* Pixel = (uint32*)Row;
+        __m128i PixelX = _mm_setr_epi32(MinX, MinX + 1, MinX + 2, MinX + 3);
+        for (int32 XI = MinX; XI < MaxX; XI += 4) {
+            __m128i WriteMask = _mm_and_si128(
+                _mm_cmpgt_epi32(PixelX, ClipMinX_4x),
+                _mm_cmpgt_epi32(ClipMaxX_4x, PixelX)
             );
-            Destv4 = SRGB255ToLinear1(Destv4);
 
-            real32 Avg = (Destv4.r + Destv4.g + Destv4.b) / 3.0f;
-            v3 Avg3 = V3(Avg, Avg, Avg);
-            v3 Delta = Destv4.rgb - Avg3;
-            Delta *= Level;
+            __m128i OriginalDest = _mm_load_si128((__m128i*)Pixel);
+            __m128 Destr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 16), MaskFF_4x));
+            __m128 Destg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(OriginalDest, 8), MaskFF_4x));
+            __m128 Destb = _mm_cvtepi32_ps(_mm_and_si128(OriginalDest, MaskFF_4x));
+            Destr = _mm_mul_ps(Destr, Destr);
+            Destg = _mm_mul_ps(Destg, Destg);
+            Destb = _mm_mul_ps(Destb, Destb);
+
+            __m128 Avg = _mm_mul_ps(_mm_add_ps(_mm_add_ps(Destr, Destg), Destb), OneThird_4x);
+            __m128 Resultr = _mm_add_ps(Avg, _mm_mul_ps(_mm_sub_ps(Destr, Avg), Level_4x));
+            __m128 Resultg = _mm_add_ps(Avg, _mm_mul_ps(_mm_sub_ps(Destg, Avg), Level_4x));
+            __m128 Resultb = _mm_add_ps(Avg, _mm_mul_ps(_mm_sub_ps(Destb, Avg), Level_4x));
 
-            v4 Result = V4(Delta + Avg3, Destv4.a);
-            Result = Linear1ToSRGB255(Result);
+            // NOTE(sen) Oversaturating can leave the 0-255 range
+            Resultr = _mm_sqrt_ps(_mm_min_ps(_mm_max_ps(Resultr, Zero_4x), MaxColorValue_4x));
+            Resultg = _mm_sqrt_ps(_mm_min_ps(_mm_max_ps(Resultg, Zero_4x), MaxColorValue_4x));
+            Resultb = _mm_sqrt_ps(_mm_min_ps(_mm_max_ps(Resultb, Zero_4x), MaxColorValue_4x));
 
-            *Dest =
-                (RoundReal32ToUint32(Result.a) << 24) |
-                (RoundReal32ToUint32(Result.r) << 16) |
-                (RoundReal32ToUint32(Result.g) << 8) |
-                (RoundReal32ToUint32(Result.b));
+            __m128i Out = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(_mm_cvtps_epi32(Resultr), 16), _mm_slli_epi32(_mm_cvtps_epi32(Resultg), 8)),
+                _mm_or_si128(_mm_cvtps_epi32(Resultb), _mm_and_si128(OriginalDest, MaskFF000000_4x))
+            );
+            __m128i MaskedOut = _mm_or_si128(
+                _mm_and_si128(WriteMask, Out),
+                _mm_andnot_si128(WriteMask, OriginalDest)
+            );
+            _mm_store_si128((__m128i*)Pixel, MaskedOut);
 
-            ++Dest;
+            Pixel += 4;
+            PixelX = _mm_add_epi32(PixelX, Four_4x);
         }
-        DestRow += Buffer->Pitch;
+        Row += 2 * Buffer->Pitch;
     }
 }
 
@@ -1258,16 +3569,34 @@ internal void DrawMatte(
     }
 }
 
+/// EntryOffsets limits the walk to those entries (in push order), otherwise it does the whole push buffer
 internal void RenderGroupToOutput(
     render_group* RenderGroup, loaded_bitmap* OutputTarget,
-    rectangle2i ClipRect, bool32 Even
+    rectangle2i ClipRect, bool32 Even,
+    uint32* EntryOffsets = 0, uint32 EntryCount = 0, rectangle2i* EntryClipRects = 0
 ) {
     TIMED_FUNCTION();
 
     real32 NullPixelsToMeters = 1.0f;
+    real32 PixelsToMeters = SafeRatio1(1.0f, RenderGroup->Transform.MetersToPixels);
 
+    uint32 EntryIndex = 0;
     for (uint32 BaseAddress = 0; BaseAddress < RenderGroup->PushBufferSize;) {
 
+        rectangle2i EntryClipRect = ClipRect;
+        if (EntryOffsets) {
+            if (EntryIndex == EntryCount) {
+                break;
+            }
+            if (EntryClipRects) {
+                EntryClipRect = EntryClipRects[EntryIndex];
+            }
+            BaseAddress = EntryOffsets[EntryIndex++];
+            if (!HasArea(EntryClipRect)) {
+                continue;
+            }
+        }
+
         render_group_entry_header* Header =
             (render_group_entry_header*)(RenderGroup->PushBufferBase + BaseAddress);
         void* Data = (uint8*)Header + sizeof(render_group_entry_header);
@@ -1277,10 +3606,7 @@ internal void RenderGroupToOutput(
         case RenderGroupEntryType_render_entry_clear: {
             render_entry_clear* Entry = (render_entry_clear*)Data;
 
-            DrawRectangle(
-                OutputTarget, V2(0, 0), V2i(OutputTarget->Width, OutputTarget->Height),
-                Entry->Color, ClipRect, Even
-            );
+            ClearRectangle(OutputTarget, Entry->Color, EntryClipRect, Even);
 
             BaseAddress += sizeof(*Entry);
         } break;
@@ -1288,7 +3614,7 @@ internal void RenderGroupToOutput(
         case RenderGroupEntryType_render_entry_saturation: {
             render_entry_saturation* Entry = (render_entry_saturation*)Data;
 
-            ChangeSaturation(OutputTarget, Entry->Level);
+            ChangeSaturation(OutputTarget, Entry->Level, EntryClipRect, Even);
 
             BaseAddress += sizeof(*Entry);
         } break;
@@ -1306,23 +3632,35 @@ internal void RenderGroupToOutput(
                 Entry->Bitmap, 0, 0, 0, 0, NullPixelsToMeters
             );
 #else
-            DrawRectangleQuickly(
-                OutputTarget,
-                Entry->P,
-                V2(Entry->Size.x, 0),
-                V2(0, Entry->Size.y),
-                Entry->Color,
-                Entry->Bitmap, NullPixelsToMeters,
-                ClipRect,
-                Even
-            );
+            if (RenderGroup->Pipeline == RenderPipeline_FixedPoint) {
+                DrawRectangleQuicklyFixed(
+                    OutputTarget,
+                    Entry->P,
+                    V2(Entry->Size.x, 0),
+                    V2(0, Entry->Size.y),
+                    Entry->Color,
+                    Entry->Bitmap,
+                    EntryClipRect,
+                    Even
+                );
+            } else {
+                DrawRectangleAxisAligned(
+                    OutputTarget,
+                    Entry->P,
+                    Entry->Size,
+                    Entry->Color,
+                    Entry->Bitmap, NullPixelsToMeters,
+                    EntryClipRect,
+                    Even
+                );
+            }
 #endif
             BaseAddress += sizeof(*Entry);
         } break;
 
         case RenderGroupEntryType_render_entry_rectangle: {
             render_entry_rectangle* Entry = (render_entry_rectangle*)Data;
-            DrawRectangle(OutputTarget, Entry->P, Entry->P + Entry->Dim, Entry->Color, ClipRect, Even);
+            DrawRectangle(OutputTarget, Entry->P, Entry->P + Entry->Dim, Entry->Color, EntryClipRect, Even);
             BaseAddress += sizeof(*Entry);
         } break;
 
@@ -1338,15 +3676,10 @@ internal void RenderGroupToOutput(
 
             v2 PMax = P + Entry->XAxis + Entry->YAxis;
 
-            DrawRectangle(OutputTarget, P - Dim, P + Dim, Entry->Color, ClipRect, Even);
-            DrawRectangle(OutputTarget, PX - Dim, PX + Dim, Entry->Color, ClipRect, Even);
-            DrawRectangle(OutputTarget, PY - Dim, PY + Dim, Entry->Color, ClipRect, Even);
-            DrawRectangle(OutputTarget, PMax - Dim, PMax + Dim, Entry->Color, ClipRect, Even);
-            DrawRectangleSlowly(
-                OutputTarget, Entry->Origin, Entry->XAxis, Entry->YAxis, Entry->Color,
-                Entry->Texture, Entry->NormalMap,
-                Entry->Top, Entry->Middle, Entry->Bottom, PixelsToMeters
-            );
+            DrawRectangle(OutputTarget, P - Dim, P + Dim, Entry->Color, EntryClipRect, Even);
+            DrawRectangle(OutputTarget, PX - Dim, PX + Dim, Entry->Color, EntryClipRect, Even);
+            DrawRectangle(OutputTarget, PY - Dim, PY + Dim, Entry->Color, EntryClipRect, Even);
+            DrawRectangle(OutputTarget, PMax - Dim, PMax + Dim, Entry->Color, EntryClipRect, Even);
 
             for (uint32 PIndex = 0; PIndex < ArrayCount(Entry->Points); PIndex++) {
                 v2 Point = Entry->Points[PIndex];
@@ -1354,6 +3687,20 @@ internal void RenderGroupToOutput(
                 DrawRectangle(OutputTarget, PPoint - Dim, PPoint + Dim, Entry->Color.r, Entry->Color.g, Entry->Color.b);
             }
 #endif
+            if (Entry->NormalMap) {
+                DrawRectangleLit(
+                    OutputTarget, Entry->Origin, Entry->XAxis, Entry->YAxis, Entry->Color,
+                    Entry->Texture, Entry->NormalMap,
+                    Entry->Top, Entry->Middle, Entry->Bottom, PixelsToMeters,
+                    EntryClipRect, Even
+                );
+            } else {
+                DrawRectangleQuickly(
+                    OutputTarget, Entry->Origin, Entry->XAxis, Entry->YAxis, Entry->Color,
+                    Entry->Texture, NullPixelsToMeters,
+                    EntryClipRect, Even
+                );
+            }
             BaseAddress += sizeof(*Entry);
         } break;
             InvalidDefaultCase;
@@ -1366,12 +3713,287 @@ struct tile_render_work {
     render_group* RenderGroup;
     loaded_bitmap* OutputTarget;
     rectangle2i ClipRect;
+    // NOTE(sen) Push buffer offsets of the entries that overlap ClipRect, 0 means walk everything
+    uint32* EntryOffsets;
+    uint32 EntryCount;
+    // NOTE(sen) Same length as EntryOffsets, the part of ClipRect each entry still shows in, 0 means all of it
+    rectangle2i* EntryClipRects;
 };
 
+/// Screen bounds of an entry and its size in the push buffer (including the header)
+internal rectangle2i GetRenderEntryScreenBounds(
+    render_group_entry_header* Header, loaded_bitmap* OutputTarget, uint32* EntrySize
+) {
+    void* Data = (uint8*)Header + sizeof(render_group_entry_header);
+    rectangle2i Result;
+    Result.MinX = 0;
+    Result.MinY = 0;
+    Result.MaxX = OutputTarget->Width;
+    Result.MaxY = OutputTarget->Height;
+    switch (Header->Type) {
+    case RenderGroupEntryType_render_entry_clear: {
+        *EntrySize = sizeof(render_entry_clear);
+    } break;
+    case RenderGroupEntryType_render_entry_saturation: {
+        *EntrySize = sizeof(render_entry_saturation);
+    } break;
+    case RenderGroupEntryType_render_entry_bitmap: {
+        render_entry_bitmap* Entry = (render_entry_bitmap*)Data;
+        Result = GetQuadScreenBounds(Entry->P, V2(Entry->Size.x, 0), V2(0, Entry->Size.y));
+        *EntrySize = sizeof(*Entry);
+    } break;
+    case RenderGroupEntryType_render_entry_rectangle: {
+        render_entry_rectangle* Entry = (render_entry_rectangle*)Data;
+        Result = GetQuadScreenBounds(Entry->P, V2(Entry->Dim.x, 0), V2(0, Entry->Dim.y));
+        *EntrySize = sizeof(*Entry);
+    } break;
+    case RenderGroupEntryType_render_entry_coordinate_system: {
+        render_entry_coordinate_system* Entry = (render_entry_coordinate_system*)Data;
+        Result = GetQuadScreenBounds(Entry->Origin, Entry->XAxis, Entry->YAxis);
+        *EntrySize = sizeof(*Entry);
+    } break;
+        InvalidDefaultCase;
+    }
+    *EntrySize += sizeof(render_group_entry_header);
+    return Result;
+}
+
+/// Pixels the entry is guaranteed to overwrite completely, no area if it doesn't hide anything
+internal rectangle2i GetRenderEntryOpaqueBounds(render_group_entry_header* Header, loaded_bitmap* OutputTarget) {
+    void* Data = (uint8*)Header + sizeof(render_group_entry_header);
+    rectangle2i Result = {};
+    switch (Header->Type) {
+    case RenderGroupEntryType_render_entry_clear: {
+        Result.MaxX = OutputTarget->Width;
+        Result.MaxY = OutputTarget->Height;
+    } break;
+    case RenderGroupEntryType_render_entry_bitmap: {
+        render_entry_bitmap* Entry = (render_entry_bitmap*)Data;
+        if (Entry->Bitmap->Opaque && Entry->Color.a >= 1.0f) {
+            // NOTE(sen) A pixel in from the edges, the rasterizer decides those by texel coordinate
+            Result.MinX = CeilReal32ToInt32(Entry->P.x) + 1;
+            Result.MinY = CeilReal32ToInt32(Entry->P.y) + 1;
+            Result.MaxX = FloorReal32ToInt32(Entry->P.x + Entry->Size.x) - 1;
+            Result.MaxY = FloorReal32ToInt32(Entry->P.y + Entry->Size.y) - 1;
+        }
+    } break;
+    case RenderGroupEntryType_render_entry_rectangle: {
+        render_entry_rectangle* Entry = (render_entry_rectangle*)Data;
+        if (Entry->Color.a >= 1.0f) {
+            Result.MinX = RoundReal32ToInt32(Entry->P.x);
+            Result.MinY = RoundReal32ToInt32(Entry->P.y);
+            Result.MaxX = RoundReal32ToInt32(Entry->P.x + Entry->Dim.x);
+            Result.MaxY = RoundReal32ToInt32(Entry->P.y + Entry->Dim.y);
+        }
+    } break;
+    // NOTE(sen) Saturation rewrites what's under it, coordinate systems have lit and transparent texels
+    case RenderGroupEntryType_render_entry_saturation:
+    case RenderGroupEntryType_render_entry_coordinate_system: {
+    } break;
+    }
+    return Result;
+}
+
+#define OCCLUSION_BLOCK_SIDE 8
+#define MAX_OCCLUSION_BLOCK_COUNT 64
+
+internal inline uint64 OcclusionBlockSpanMask(int32 MinBlock, int32 OnePastMaxBlock) {
+    uint64 Result = OnePastMaxBlock >= 64 ? ~(uint64)0 : (((uint64)1 << OnePastMaxBlock) - 1);
+    Result &= ~(((uint64)1 << MinBlock) - 1);
+    return Result;
+}
+
+/// Walks the tile's entries last to first, marking the 8x8 blocks something opaque already covers.
+/// Every entry gets clipped to the blocks still showing when it's reached, so whatever is hidden
+/// (the clear under the ground, the ground under trees) never gets filled.
+internal void CullOccludedRenderEntries(tile_render_work* Work) {
+    TIMED_FUNCTION();
+
+    rectangle2i TileRect = Work->ClipRect;
+    int32 BlockCountX = (TileRect.MaxX - TileRect.MinX + OCCLUSION_BLOCK_SIDE - 1) / OCCLUSION_BLOCK_SIDE;
+    int32 BlockCountY = (TileRect.MaxY - TileRect.MinY + OCCLUSION_BLOCK_SIDE - 1) / OCCLUSION_BLOCK_SIDE;
+    if (BlockCountX > MAX_OCCLUSION_BLOCK_COUNT || BlockCountY > MAX_OCCLUSION_BLOCK_COUNT) {
+        for (uint32 EntryIndex = 0; EntryIndex < Work->EntryCount; ++EntryIndex) {
+            Work->EntryClipRects[EntryIndex] = TileRect;
+        }
+        return;
+    }
+
+    uint64 OpaqueRows[MAX_OCCLUSION_BLOCK_COUNT];
+    for (int32 BlockY = 0; BlockY < BlockCountY; ++BlockY) {
+        OpaqueRows[BlockY] = 0;
+    }
+
+    for (uint32 EntryIndex = Work->EntryCount; EntryIndex > 0;) {
+        --EntryIndex;
+        render_group_entry_header* Header =
+            (render_group_entry_header*)(Work->RenderGroup->PushBufferBase + Work->EntryOffsets[EntryIndex]);
+        uint32 EntrySize;
+        rectangle2i Bounds = Intersect(GetRenderEntryScreenBounds(Header, Work->OutputTarget, &EntrySize), TileRect);
+
+        int32 MinBlockX = (Bounds.MinX - TileRect.MinX) / OCCLUSION_BLOCK_SIDE;
+        int32 MinBlockY = (Bounds.MinY - TileRect.MinY) / OCCLUSION_BLOCK_SIDE;
+        int32 OnePastMaxBlockX = (Bounds.MaxX - TileRect.MinX + OCCLUSION_BLOCK_SIDE - 1) / OCCLUSION_BLOCK_SIDE;
+        int32 OnePastMaxBlockY = (Bounds.MaxY - TileRect.MinY + OCCLUSION_BLOCK_SIDE - 1) / OCCLUSION_BLOCK_SIDE;
+        uint64 TouchedColumns = OcclusionBlockSpanMask(MinBlockX, OnePastMaxBlockX);
+
+        uint64 ShowingColumns = 0;
+        int32 ShowingMinBlockY = OnePastMaxBlockY;
+        int32 ShowingOnePastMaxBlockY = MinBlockY;
+        for (int32 BlockY = MinBlockY; BlockY < OnePastMaxBlockY; ++BlockY) {
+            uint64 Showing = TouchedColumns & ~OpaqueRows[BlockY];
+            if (Showing) {
+                ShowingColumns |= Showing;
+                ShowingMinBlockY = Minimum(ShowingMinBlockY, BlockY);
+                ShowingOnePastMaxBlockY = BlockY + 1;
+            }
+        }
+
+        rectangle2i* EntryClipRect = Work->EntryClipRects + EntryIndex;
+        if (!ShowingColumns) {
+            *EntryClipRect = {};
+            continue;
+        }
+        int32 ShowingMinBlockX = MinBlockX;
+        while (!(ShowingColumns & ((uint64)1 << ShowingMinBlockX))) {
+            ++ShowingMinBlockX;
+        }
+        int32 ShowingOnePastMaxBlockX = OnePastMaxBlockX;
+        while (!(ShowingColumns & ((uint64)1 << (ShowingOnePastMaxBlockX - 1)))) {
+            --ShowingOnePastMaxBlockX;
+        }
+        EntryClipRect->MinX = TileRect.MinX + ShowingMinBlockX * OCCLUSION_BLOCK_SIDE;
+        EntryClipRect->MinY = TileRect.MinY + ShowingMinBlockY * OCCLUSION_BLOCK_SIDE;
+        EntryClipRect->MaxX = TileRect.MinX + ShowingOnePastMaxBlockX * OCCLUSION_BLOCK_SIDE;
+        EntryClipRect->MaxY = TileRect.MinY + ShowingOnePastMaxBlockY * OCCLUSION_BLOCK_SIDE;
+        *EntryClipRect = Intersect(*EntryClipRect, TileRect);
+
+        rectangle2i Opaque = Intersect(GetRenderEntryOpaqueBounds(Header, Work->OutputTarget), TileRect);
+        if (HasArea(Opaque)) {
+            // NOTE(sen) Only blocks covered all the way, the ones hanging off the edge of the screen
+            // only need the part that's on it
+            int32 CoveredMinBlockX = (Opaque.MinX - TileRect.MinX + OCCLUSION_BLOCK_SIDE - 1) / OCCLUSION_BLOCK_SIDE;
+            int32 CoveredMinBlockY = (Opaque.MinY - TileRect.MinY + OCCLUSION_BLOCK_SIDE - 1) / OCCLUSION_BLOCK_SIDE;
+            int32 CoveredOnePastMaxBlockX = Opaque.MaxX == TileRect.MaxX ?
+                BlockCountX : (Opaque.MaxX - TileRect.MinX) / OCCLUSION_BLOCK_SIDE;
+            int32 CoveredOnePastMaxBlockY = Opaque.MaxY == TileRect.MaxY ?
+                BlockCountY : (Opaque.MaxY - TileRect.MinY) / OCCLUSION_BLOCK_SIDE;
+            if (CoveredMinBlockX < CoveredOnePastMaxBlockX) {
+                uint64 CoveredColumns = OcclusionBlockSpanMask(CoveredMinBlockX, CoveredOnePastMaxBlockX);
+                for (int32 BlockY = CoveredMinBlockY; BlockY < CoveredOnePastMaxBlockY; ++BlockY) {
+                    OpaqueRows[BlockY] |= CoveredColumns;
+                }
+            }
+        }
+    }
+}
+
 internal PLATFORM_WORK_QUEUE_CALLBACK(DoTiledRenderWork) {
     tile_render_work* Work = (tile_render_work*)Data;
-    RenderGroupToOutput(Work->RenderGroup, Work->OutputTarget, Work->ClipRect, true);
-    RenderGroupToOutput(Work->RenderGroup, Work->OutputTarget, Work->ClipRect, false);
+#if 1
+    if (Work->EntryClipRects) {
+        CullOccludedRenderEntries(Work);
+    }
+#endif
+    RenderGroupToOutput(
+        Work->RenderGroup, Work->OutputTarget, Work->ClipRect, true,
+        Work->EntryOffsets, Work->EntryCount, Work->EntryClipRects
+    );
+    RenderGroupToOutput(
+        Work->RenderGroup, Work->OutputTarget, Work->ClipRect, false,
+        Work->EntryOffsets, Work->EntryCount, Work->EntryClipRects
+    );
+}
+
+struct binned_render_entry {
+    uint32 Offset;
+    uint8 MinTileX;
+    uint8 MinTileY;
+    uint8 OnePastMaxTileX;
+    uint8 OnePastMaxTileY;
+};
+
+/// Works out the bounds of every entry once and gives each tile the list of entries that overlap it.
+/// The lists live in the unused end of the push buffer, returns false (and the tiles walk everything)
+/// if they don't fit.
+internal bool32 BinRenderGroupEntries(
+    render_group* RenderGroup, loaded_bitmap* OutputTarget,
+    int32 TileCountX, int32 TileCountY, int32 TileWidth, int32 TileHeight,
+    tile_render_work* WorkArray
+) {
+    TIMED_FUNCTION();
+
+    Assert(TileCountX <= 255 && TileCountY <= 255);
+    int32 TileCount = TileCountX * TileCountY;
+    for (int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex) {
+        WorkArray[TileIndex].EntryOffsets = 0;
+        WorkArray[TileIndex].EntryCount = 0;
+        WorkArray[TileIndex].EntryClipRects = 0;
+    }
+
+    rectangle2i ScreenRect;
+    ScreenRect.MinX = 0;
+    ScreenRect.MinY = 0;
+    ScreenRect.MaxX = OutputTarget->Width;
+    ScreenRect.MaxY = OutputTarget->Height;
+
+    uint8* ScratchBase = (uint8*)Align4((uintptr)(RenderGroup->PushBufferBase + RenderGroup->PushBufferSize));
+    uint8* ScratchEnd = RenderGroup->PushBufferBase + RenderGroup->MaxPushBufferSize;
+    binned_render_entry* BinnedEntries = (binned_render_entry*)ScratchBase;
+    uint32 BinnedCount = 0;
+
+    for (uint32 BaseAddress = 0; BaseAddress < RenderGroup->PushBufferSize;) {
+        render_group_entry_header* Header =
+            (render_group_entry_header*)(RenderGroup->PushBufferBase + BaseAddress);
+        uint32 EntrySize;
+        rectangle2i Bounds = Intersect(GetRenderEntryScreenBounds(Header, OutputTarget, &EntrySize), ScreenRect);
+        if (HasArea(Bounds)) {
+            if ((uint8*)(BinnedEntries + BinnedCount + 1) > ScratchEnd) {
+                return false;
+            }
+            binned_render_entry* Binned = BinnedEntries + BinnedCount++;
+            Binned->Offset = BaseAddress;
+            Binned->MinTileX = (uint8)Minimum(Bounds.MinX / TileWidth, TileCountX - 1);
+            Binned->MinTileY = (uint8)Minimum(Bounds.MinY / TileHeight, TileCountY - 1);
+            Binned->OnePastMaxTileX = (uint8)(Minimum((Bounds.MaxX - 1) / TileWidth, TileCountX - 1) + 1);
+            Binned->OnePastMaxTileY = (uint8)(Minimum((Bounds.MaxY - 1) / TileHeight, TileCountY - 1) + 1);
+            for (int32 TileY = Binned->MinTileY; TileY < Binned->OnePastMaxTileY; ++TileY) {
+                for (int32 TileX = Binned->MinTileX; TileX < Binned->OnePastMaxTileX; ++TileX) {
+                    ++WorkArray[TileY * TileCountX + TileX].EntryCount;
+                }
+            }
+        }
+        BaseAddress += EntrySize;
+    }
+
+    uint8* ListsAt = (uint8*)(BinnedEntries + BinnedCount);
+    for (int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex) {
+        tile_render_work* Work = WorkArray + TileIndex;
+        uint8* OnePastLists = ListsAt + Work->EntryCount * (sizeof(rectangle2i) + sizeof(uint32));
+        if (OnePastLists > ScratchEnd) {
+            for (int32 ResetIndex = 0; ResetIndex < TileCount; ++ResetIndex) {
+                WorkArray[ResetIndex].EntryOffsets = 0;
+                WorkArray[ResetIndex].EntryCount = 0;
+                WorkArray[ResetIndex].EntryClipRects = 0;
+            }
+            return false;
+        }
+        Work->EntryClipRects = (rectangle2i*)ListsAt;
+        Work->EntryOffsets = (uint32*)(Work->EntryClipRects + Work->EntryCount);
+        ListsAt = OnePastLists;
+        Work->EntryCount = 0;
+    }
+
+    for (uint32 BinnedIndex = 0; BinnedIndex < BinnedCount; ++BinnedIndex) {
+        binned_render_entry* Binned = BinnedEntries + BinnedIndex;
+        for (int32 TileY = Binned->MinTileY; TileY < Binned->OnePastMaxTileY; ++TileY) {
+            for (int32 TileX = Binned->MinTileX; TileX < Binned->OnePastMaxTileX; ++TileX) {
+                tile_render_work* Work = WorkArray + TileY * TileCountX + TileX;
+                Work->EntryOffsets[Work->EntryCount++] = Binned->Offset;
+            }
+        }
+    }
+    return true;
 }
 
 internal void RenderGroupToOutput(render_group* RenderGroup, loaded_bitmap* OutputTarget) {
@@ -1386,46 +4008,145 @@ internal void RenderGroupToOutput(render_group* RenderGroup, loaded_bitmap* Outp
     Work.RenderGroup = RenderGroup;
     Work.OutputTarget = OutputTarget;
     Work.ClipRect = ClipRect;
+    Work.EntryOffsets = 0;
+    Work.EntryCount = 0;
+    Work.EntryClipRects = 0;
     DoTiledRenderWork(0, &Work);
 }
 
 
+#define MAX_RENDER_TILE_COUNT 1024
+
+/// Persists across frames so tiles can be handed out most expensive first
+struct render_tile_schedule {
+    // NOTE(sen) Threads pulling tiles, the high priority workers plus whoever waits in CompleteAllWork
+    uint32 WorkerCount;
+
+    // NOTE(sen) The grid the costs below belong to, they're thrown out when it changes
+    int32 TileCountX;
+    int32 TileCountY;
+    int32 TileWidth;
+    int32 TileHeight;
+
+    uint64 TileCycles[MAX_RENDER_TILE_COUNT];
+    uint16 Order[MAX_RENDER_TILE_COUNT];
+    tile_render_work Tiles[MAX_RENDER_TILE_COUNT];
+
+    uint32 volatile NextOrderIndex;
+    uint32 TileCount;
+};
+
+internal render_tile_schedule* AllocateRenderTileSchedule(memory_arena* Arena, uint32 ThreadCount) {
+    render_tile_schedule* Result = PushStruct(Arena, render_tile_schedule);
+    // NOTE(sen) Platforms that don't say get treated as a quad core
+    Result->WorkerCount = Minimum(ThreadCount ? ThreadCount : 3, 127) + 1;
+    Result->TileCountX = 0;
+    Result->TileCountY = 0;
+    return Result;
+}
+
+internal PLATFORM_WORK_QUEUE_CALLBACK(DoScheduledTileWork) {
+    render_tile_schedule* Schedule = (render_tile_schedule*)Data;
+    for (;;) {
+        uint32 OrderIndex = AtomicAddU32(&Schedule->NextOrderIndex, 1);
+        if (OrderIndex >= Schedule->TileCount) {
+            break;
+        }
+        uint32 TileIndex = Schedule->Order[OrderIndex];
+        uint64 StartCycles = __rdtsc();
+        DoTiledRenderWork(Queue, Schedule->Tiles + TileIndex);
+        Schedule->TileCycles[TileIndex] = __rdtsc() - StartCycles;
+    }
+}
+
+/// 64x64 tiles keep the rows a worker touches in its own cache for both passes. They get smaller
+/// until every worker has a few to pull, so an expensive tile can't set the frame time on its own.
+internal void ChooseTileGrid(render_tile_schedule* Schedule, int32 Width, int32 Height) {
+    int32 TileSide = 64;
+    while (TileSide > 16 &&
+           ((Width + TileSide - 1) / TileSide) * ((Height + TileSide - 1) / TileSide) < (int32)(4 * Schedule->WorkerCount)) {
+        TileSide /= 2;
+    }
+    while (((Width + TileSide - 1) / TileSide) * ((Height + TileSide - 1) / TileSide) > MAX_RENDER_TILE_COUNT ||
+           (Width + TileSide - 1) / TileSide > 255 || (Height + TileSide - 1) / TileSide > 255) {
+        TileSide *= 2;
+    }
+
+    int32 TileCountX = (Width + TileSide - 1) / TileSide;
+    int32 TileCountY = (Height + TileSide - 1) / TileSide;
+    if (Schedule->TileCountX != TileCountX || Schedule->TileCountY != TileCountY || Schedule->TileWidth != TileSide) {
+        Schedule->TileCountX = TileCountX;
+        Schedule->TileCountY = TileCountY;
+        Schedule->TileWidth = TileSide;
+        Schedule->TileHeight = TileSide;
+        for (int32 TileIndex = 0; TileIndex < TileCountX * TileCountY; ++TileIndex) {
+            Schedule->TileCycles[TileIndex] = 0;
+            Schedule->Order[TileIndex] = (uint16)TileIndex;
+        }
+    }
+}
+
 internal void TiledRenderGroupToOutput(
     platform_work_queue* RenderQueue,
-    render_group* RenderGroup, loaded_bitmap* OutputTarget
+    render_group* RenderGroup, loaded_bitmap* OutputTarget,
+    render_tile_schedule* Schedule
 ) {
     Assert(RenderGroup->InsideRender);
-    int32 const TileCountX = 4;
-    int32 const TileCountY = 4;
-    tile_render_work WorkArray[TileCountX * TileCountY];
     Assert(((uintptr)OutputTarget->Memory & 15) == 0);
-    int32 TileWidth = OutputTarget->Width / TileCountX;
-    int32 TileHeight = OutputTarget->Height / TileCountY;
-    TileWidth = ((TileWidth + 3) / 4) * 4;
-    int32 WorkCount = 0;
+
+    ChooseTileGrid(Schedule, OutputTarget->Width, OutputTarget->Height);
+    int32 TileCountX = Schedule->TileCountX;
+    int32 TileCountY = Schedule->TileCountY;
+    int32 TileWidth = Schedule->TileWidth;
+    int32 TileHeight = Schedule->TileHeight;
+    int32 TileCount = TileCountX * TileCountY;
+
     for (int32 TileY = 0; TileY < TileCountY; ++TileY) {
         for (int32 TileX = 0; TileX < TileCountX; ++TileX) {
             rectangle2i ClipRect;
             ClipRect.MinX = TileX * TileWidth;
-            ClipRect.MaxX = ClipRect.MinX + TileWidth;
-            if (TileX == TileCountX - 1) {
-                ClipRect.MaxX = OutputTarget->Width;
-            }
+            ClipRect.MaxX = Minimum(ClipRect.MinX + TileWidth, OutputTarget->Width);
             ClipRect.MinY = TileY * TileHeight;
-            ClipRect.MaxY = ClipRect.MinY + TileHeight;
-            if (TileY == TileCountY - 1) {
-                ClipRect.MaxY = OutputTarget->Height;
-            }
-            tile_render_work* Work = WorkArray + WorkCount++;
+            ClipRect.MaxY = Minimum(ClipRect.MinY + TileHeight, OutputTarget->Height);
+            tile_render_work* Work = Schedule->Tiles + TileY * TileCountX + TileX;
             Work->ClipRect = ClipRect;
             Work->OutputTarget = OutputTarget;
             Work->RenderGroup = RenderGroup;
+        }
+    }
+
 #if 1
-            Platform.AddEntry(RenderQueue, DoTiledRenderWork, Work);
+    BinRenderGroupEntries(RenderGroup, OutputTarget, TileCountX, TileCountY, TileWidth, TileHeight, Schedule->Tiles);
 #else
-            DoTiledRenderWork(RenderQueue, Work);
+    for (int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex) {
+        Schedule->Tiles[TileIndex].EntryOffsets = 0;
+        Schedule->Tiles[TileIndex].EntryCount = 0;
+        Schedule->Tiles[TileIndex].EntryClipRects = 0;
+    }
 #endif
+
+    // NOTE(sen) Most expensive last frame goes first, the cheap ones fill in the gaps at the end.
+    // Last frame's order is nearly sorted already so insertion sort is about one pass.
+    for (int32 OrderIndex = 1; OrderIndex < TileCount; ++OrderIndex) {
+        uint16 TileIndex = Schedule->Order[OrderIndex];
+        uint64 Cycles = Schedule->TileCycles[TileIndex];
+        int32 InsertIndex = OrderIndex;
+        while (InsertIndex > 0 && Schedule->TileCycles[Schedule->Order[InsertIndex - 1]] < Cycles) {
+            Schedule->Order[InsertIndex] = Schedule->Order[InsertIndex - 1];
+            --InsertIndex;
         }
+        Schedule->Order[InsertIndex] = TileIndex;
+    }
+
+    Schedule->TileCount = (uint32)TileCount;
+    Schedule->NextOrderIndex = 0;
+    uint32 PullerCount = Minimum(Schedule->WorkerCount, (uint32)TileCount);
+    for (uint32 PullerIndex = 0; PullerIndex < PullerCount; ++PullerIndex) {
+#if 1
+        Platform.AddEntry(RenderQueue, DoScheduledTileWork, Schedule);
+#else
+        DoScheduledTileWork(RenderQueue, Schedule);
+#endif
     }
     Platform.CompleteAllWork(RenderQueue);
 }
@@ -204,6 +204,8 @@ struct task_with_memory {
     temporary_memory MemoryFlush;
 };
 
+struct render_tile_schedule;
+
 struct transient_state {
     bool32 IsInitialized;
     memory_arena TranArena;
@@ -215,6 +217,10 @@ struct transient_state {
     environment_map EnvMaps[3];
     platform_work_queue* HighPriorityQueue;
     platform_work_queue* LowPriorityQueue;
+    render_tile_schedule* WorldTileSchedule;
+    render_tile_schedule* DEBUGTileSchedule;
+    // NOTE(sen) Last frame's, for the debug overlay
+    uint32 WorldCulledEntryCount;
     game_assets* Assets;
 };
 
@@ -1,7 +1,7 @@
 #if !defined(HANDMADE_WORLD_CPP)
 #define HANDMADE_WORLD_CPP
 
-#include "../intrinsics.H"
+#include "../intrinsics.h"
 #include "../types.h"
 #include "../util.h"
 #include "memory.cpp"
@@ -35,6 +35,62 @@ internal inline uint32 GetThreadId() {
     uint32 ThreadID = *(uint32*)(ThreadLocalStorage + 0x48);
     return ThreadID;
 }
+internal inline void CPUID(uint32 Leaf, uint32 Subleaf, uint32* Registers) {
+    __cpuidex((int*)Registers, Leaf, Subleaf);
+}
+internal inline uint64 GetXCR0() {
+    uint64 Result = _xgetbv(0);
+    return Result;
+}
+#elif COMPILER_LLVM
+#include <x86intrin.h>
+#include <cpuid.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+// NOTE(sen) x86 doesn't reorder stores with stores or loads with loads, we only need to stop the compiler
+#define CompletePreviousWritesBeforeFutureWrites asm volatile("" ::: "memory")
+#define CompletePreviousReadsBeforeFutureReads asm volatile("" ::: "memory")
+internal inline uint32 AtomicCompareExchangeUint32(uint32 volatile* Value, uint32 New, uint32 Expected) {
+    uint32 Result = __sync_val_compare_and_swap(Value, Expected, New);
+    return Result;
+}
+internal inline uint32 AtomicAddU32(uint32 volatile* Value, int32 Addend) {
+    uint32 Result = __atomic_fetch_add(Value, Addend, __ATOMIC_SEQ_CST);
+    return Result;
+}
+internal inline uint64 AtomicAddU64(uint64 volatile* Value, int64 Addend) {
+    uint64 Result = __atomic_fetch_add(Value, Addend, __ATOMIC_SEQ_CST);
+    return Result;
+}
+internal inline uint32 AtomicExchangeU32(uint32 volatile* Value, int32 New) {
+    uint32 Result = __atomic_exchange_n(Value, New, __ATOMIC_SEQ_CST);
+    return Result;
+}
+internal inline uint64 AtomicExchangeU64(uint64 volatile* Value, int64 New) {
+    uint64 Result = __atomic_exchange_n(Value, New, __ATOMIC_SEQ_CST);
+    return Result;
+}
+// NOTE(sen) gettid is a syscall so cache it per thread. Default TLS model, the game library gets
+// dlopen'd again on every reload and initial-exec would use up the static TLS space each time.
+global_variable __thread uint32 CachedThreadID;
+internal inline uint32 GetThreadId() {
+    uint32 ThreadID = CachedThreadID;
+    if (ThreadID == 0) {
+        ThreadID = (uint32)syscall(SYS_gettid);
+        CachedThreadID = ThreadID;
+    }
+    return ThreadID;
+}
+internal inline void CPUID(uint32 Leaf, uint32 Subleaf, uint32* Registers) {
+    __cpuid_count(Leaf, Subleaf, Registers[0], Registers[1], Registers[2], Registers[3]);
+}
+// NOTE(sen) _xgetbv needs -mxsave, the instruction itself is fine to use once OSXSAVE is set
+internal inline uint64 GetXCR0() {
+    uint32 Low, High;
+    asm volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+    uint64 Result = ((uint64)High << 32) | Low;
+    return Result;
+}
 #endif
 
 internal inline int32 RoundReal32ToInt32(real32 X) {
@@ -87,6 +143,11 @@ internal inline bit_scan_result FindLeastSignificantSetBit(uint32 Value) {
 
 #if COMPILER_MSVC
     Result.Found = _BitScanForward((unsigned long*)&Result.Index, Value);
+#elif COMPILER_LLVM
+    if (Value) {
+        Result.Index = __builtin_ctz(Value);
+        Result.Found = true;
+    }
 #else
     for (uint32 Test = 0; Test < 32; ++Test) {
         if (Value & (1 << Test)) {
@@ -99,6 +160,28 @@ internal inline bit_scan_result FindLeastSignificantSetBit(uint32 Value) {
     return Result;
 }
 
+#if COMPILER_MSVC || COMPILER_LLVM
+// NOTE(sen) The OS also has to save the ymm registers on context switches, that's the XCR0 check
+internal inline bool32 CPUSupportsAVX2() {
+    uint32 Registers[4];
+    CPUID(0, 0, Registers);
+    uint32 MaxLeaf = Registers[0];
+    if (MaxLeaf < 7) {
+        return false;
+    }
+    CPUID(1, 0, Registers);
+    bool32 FMA = (Registers[2] >> 12) & 1;
+    bool32 OSXSAVE = (Registers[2] >> 27) & 1;
+    bool32 AVX = (Registers[2] >> 28) & 1;
+    if (!(FMA && OSXSAVE && AVX) || (GetXCR0() & 6) != 6) {
+        return false;
+    }
+    CPUID(7, 0, Registers);
+    bool32 AVX2 = (Registers[1] >> 5) & 1;
+    return AVX2;
+}
+#endif
+
 internal inline real32 SquareRoot(real32 X) {
     return sqrtf(X);
 }
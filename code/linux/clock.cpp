@@ -0,0 +1,77 @@
+#if !defined(CLOCK_CPP)
+#define CLOCK_CPP
+
+#include "../types.h"
+#include "../util.h"
+#include <errno.h>
+#include <time.h>
+
+timespec linux_get_wall_clock() {
+    timespec result;
+    clock_gettime(CLOCK_MONOTONIC, &result);
+    return result;
+}
+
+real32 linux_get_seconds_elapsed(timespec start, timespec end) {
+    real32 result = (real32)(end.tv_sec - start.tv_sec) + (real32)(end.tv_nsec - start.tv_nsec) * 1e-9f;
+    return result;
+}
+
+timespec linux_add_nanoseconds(timespec time, int64 nanoseconds) {
+    int64 total = (int64)time.tv_nsec + nanoseconds;
+    timespec result;
+    result.tv_sec = time.tv_sec + total / 1000000000;
+    result.tv_nsec = total % 1000000000;
+    if (result.tv_nsec < 0) {
+        result.tv_nsec += 1000000000;
+        result.tv_sec -= 1;
+    }
+    return result;
+}
+
+/// Fixed-timestep scheduler, frame n starts at first_frame_start + n * target
+struct FramePacer {
+    int64 target_nanoseconds_per_frame;
+    timespec next_frame_start;
+    timespec last_frame_start;
+
+    uint64 frame_count;
+    uint64 missed_frame_count;
+    real32 last_overshoot_seconds;
+    real32 max_overshoot_seconds;
+    real32 total_overshoot_seconds;
+};
+
+FramePacer create_frame_pacer(real32 refresh_hz) {
+    FramePacer pacer = {};
+    pacer.target_nanoseconds_per_frame = (int64)(1e9 / (real64)refresh_hz);
+    pacer.last_frame_start = linux_get_wall_clock();
+    pacer.next_frame_start = linux_add_nanoseconds(pacer.last_frame_start, pacer.target_nanoseconds_per_frame);
+    return pacer;
+}
+
+/// Sleeps until the next frame boundary and returns the measured length of the frame that just ended
+real32 wait_for_next_frame(FramePacer* pacer) {
+    timespec now = linux_get_wall_clock();
+    if (linux_get_seconds_elapsed(now, pacer->next_frame_start) > 0.0f) {
+        // NOTE(sen) Absolute deadline so time spent before the sleep doesn't accumulate as drift
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &pacer->next_frame_start, 0) == EINTR) {}
+        now = linux_get_wall_clock();
+        pacer->last_overshoot_seconds = linux_get_seconds_elapsed(pacer->next_frame_start, now);
+        pacer->total_overshoot_seconds += pacer->last_overshoot_seconds;
+        pacer->max_overshoot_seconds = Maximum(pacer->max_overshoot_seconds, pacer->last_overshoot_seconds);
+        pacer->next_frame_start = linux_add_nanoseconds(pacer->next_frame_start, pacer->target_nanoseconds_per_frame);
+    } else {
+        // NOTE(sen) Missed the deadline, start over from now instead of trying to catch up
+        ++pacer->missed_frame_count;
+        pacer->last_overshoot_seconds = 0.0f;
+        pacer->next_frame_start = linux_add_nanoseconds(now, pacer->target_nanoseconds_per_frame);
+    }
+
+    real32 result = linux_get_seconds_elapsed(pacer->last_frame_start, now);
+    pacer->last_frame_start = now;
+    ++pacer->frame_count;
+    return result;
+}
+
+#endif
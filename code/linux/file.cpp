@@ -0,0 +1,153 @@
+#if !defined(FILE_CPP)
+#define FILE_CPP
+
+#include "../types.h"
+#include "../game/lib.hpp"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct LinuxFileHandle {
+    int fd;
+    // NOTE(sen) Only set in mmap mode, reads become memcpy's out of the mapping
+    uint8* mapped;
+    uint64 mapped_size;
+};
+
+struct LinuxFileGroup {
+    DIR* dir;
+    char* extension;
+};
+
+global_variable char* global_data_directory = (char*)".";
+global_variable bool32 global_map_asset_files;
+
+void linux_init_file_api(char* data_directory, bool32 map_asset_files) {
+    global_data_directory = data_directory;
+    global_map_asset_files = map_asset_files;
+}
+
+bool32 has_extension(char* filename, char* extension) {
+    size_t filename_length = strlen(filename);
+    size_t extension_length = strlen(extension);
+    bool32 result = filename_length > extension_length &&
+        strcmp(filename + filename_length - extension_length, extension) == 0;
+    return result;
+}
+
+// NOTE(sen) Leaves the group's directory stream positioned on the next matching regular file
+struct dirent* next_file_of_type(LinuxFileGroup* group) {
+    struct dirent* result = 0;
+    while ((result = readdir(group->dir))) {
+        if ((result->d_type == DT_REG || result->d_type == DT_LNK || result->d_type == DT_UNKNOWN) &&
+            has_extension(result->d_name, group->extension)) {
+            break;
+        }
+    }
+    return result;
+}
+
+PLATFORM_GET_ALL_FILES_OF_TYPE_BEGIN(linux_get_all_files_of_type_begin) {
+    platform_file_group result = {};
+    LinuxFileGroup* group = (LinuxFileGroup*)calloc(1, sizeof(LinuxFileGroup));
+    result.Platform = group;
+
+    switch (Type) {
+    case PlatformFileType_AssetFile: group->extension = (char*)".hha"; break;
+    case PlatformFileType_SavedGameFile: group->extension = (char*)".hhs"; break;
+        InvalidDefaultCase;
+    };
+
+    group->dir = opendir(global_data_directory);
+    if (group->dir) {
+        while (next_file_of_type(group)) {
+            ++result.FileCount;
+        }
+        rewinddir(group->dir);
+    }
+
+    return result;
+}
+
+PLATFORM_GET_ALL_FILES_OF_TYPE_END(linux_get_all_files_of_type_end) {
+    LinuxFileGroup* group = (LinuxFileGroup*)FileGroup->Platform;
+    if (group) {
+        if (group->dir) {
+            closedir(group->dir);
+        }
+        free(group);
+    }
+}
+
+PLATFORM_FILE_ERROR(linux_file_error) {
+#if HANDMADE_INTERNAL
+    fprintf(stderr, "LINUX FILE ERROR: %s\n", Message);
+#endif
+    Handle->NoErrors = false;
+}
+
+PLATFORM_OPEN_FILE(linux_open_next_file) {
+    LinuxFileGroup* group = (LinuxFileGroup*)FileGroup->Platform;
+    platform_file_handle result = {};
+    struct dirent* entry = group->dir ? next_file_of_type(group) : 0;
+    if (entry) {
+        LinuxFileHandle* handle = (LinuxFileHandle*)calloc(1, sizeof(LinuxFileHandle));
+        result.Platform = handle;
+        if (handle) {
+            handle->fd = openat(dirfd(group->dir), entry->d_name, O_RDONLY | O_CLOEXEC);
+            result.NoErrors = handle->fd != -1;
+            if (result.NoErrors && global_map_asset_files) {
+                struct stat file_stat;
+                if (fstat(handle->fd, &file_stat) == 0 && file_stat.st_size > 0) {
+                    void* mapped = mmap(0, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, handle->fd, 0);
+                    if (mapped != MAP_FAILED) {
+                        // NOTE(sen) Asset loads jump all over the file
+                        madvise(mapped, (size_t)file_stat.st_size, MADV_RANDOM);
+                        handle->mapped = (uint8*)mapped;
+                        handle->mapped_size = (uint64)file_stat.st_size;
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/// Safe to call from multiple threads on the same handle, there is no shared file position
+PLATFORM_READ_DATA_FROM_FILE(linux_read_data_from_file) {
+    if (PlatformNoFileErrors(Source)) {
+        LinuxFileHandle* handle = (LinuxFileHandle*)Source->Platform;
+        if (handle->mapped) {
+            if (Offset + Size <= handle->mapped_size) {
+                memcpy(Dest, handle->mapped + Offset, Size);
+            } else {
+                linux_file_error(Source, (char*)"Read file failed");
+            }
+        } else {
+            uint8* dest = (uint8*)Dest;
+            uint64 bytes_left = Size;
+            while (bytes_left > 0) {
+                ssize_t bytes_read = pread(handle->fd, dest, bytes_left, (off_t)Offset);
+                if (bytes_read > 0) {
+                    dest += bytes_read;
+                    Offset += bytes_read;
+                    bytes_left -= bytes_read;
+                } else if (bytes_read == -1 && errno == EINTR) {
+                    continue;
+                } else {
+                    linux_file_error(Source, (char*)"Read file failed");
+                    break;
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -1,15 +1,178 @@
+#if !defined(GAMECODE_CPP)
+#define GAMECODE_CPP
+
 #include "../game/lib.hpp"
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 struct GameCode {
     void* game_dll;
+    timespec last_write_time;
     game_update_and_render* game_update_and_render;
+    game_get_sound_samples* game_get_sound_samples;
+    debug_game_frame_end* debug_game_frame_end;
+    bool32 is_valid;
 };
 
-GameCode load_game_code() {
+/// Writes the directory of the running executable, including the trailing slash
+void get_exe_directory(char* dest, size_t dest_count) {
+    ssize_t length = readlink("/proc/self/exe", dest, dest_count - 1);
+    if (length < 0) {
+        length = 0;
+    }
+    dest[length] = '\0';
+    char* one_past_last_slash = dest;
+    for (char* scan = dest; *scan; ++scan) {
+        if (*scan == '/') {
+            one_past_last_slash = scan + 1;
+        }
+    }
+    *one_past_last_slash = '\0';
+}
+
+void build_exe_path_filename(char* filename, size_t dest_count, char* dest) {
+    get_exe_directory(dest, dest_count);
+    size_t directory_length = strlen(dest);
+    snprintf(dest + directory_length, dest_count - directory_length, "%s", filename);
+}
+
+timespec get_last_write_time(char* filename) {
+    timespec result = {};
+    struct stat file_stat;
+    if (stat(filename, &file_stat) == 0) {
+        result = file_stat.st_mtim;
+    }
+    return result;
+}
+
+// NOTE(sen) Bumped on every load so no two copies ever share a path
+global_variable uint32 global_game_code_load_count;
+
+/// Loads a private copy of the library so the build can overwrite the original while we run it.
+/// dlopen hands back an already loaded object if the path matches, so every copy gets a name of its
+/// own (pid and load count) next to the original. The copy is unlinked as soon as it's mapped.
+GameCode load_game_code(char* source) {
     GameCode game_code = {};
-    game_code.game_dll = dlopen("/home/khvorova/Projects/handmade-hero/build/game_lib.so", RTLD_LAZY);
-    game_code.game_update_and_render =
-        (game_update_and_render*)dlsym(game_code.game_dll, "GameUpdateAndRender");
+    game_code.last_write_time = get_last_write_time(source);
+
+    int source_fd = open(source, O_RDONLY | O_CLOEXEC);
+    if (source_fd == -1) {
+        return game_code;
+    }
+
+    char* source_filename = strrchr(source, '/') ? strrchr(source, '/') + 1 : source;
+    char copy_path[PATH_MAX];
+    snprintf(
+        copy_path, sizeof(copy_path), "%.*sgame_lib_%d_%u.so",
+        (int)(source_filename - source), source, (int)getpid(), global_game_code_load_count++
+    );
+
+    struct stat source_stat;
+    int copy_fd = open(copy_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0700);
+    bool32 copied = copy_fd != -1 && fstat(source_fd, &source_stat) == 0;
+    if (copied) {
+        off_t offset = 0;
+        while (offset < source_stat.st_size) {
+            ssize_t bytes_copied = sendfile(copy_fd, source_fd, &offset, source_stat.st_size - offset);
+            if (bytes_copied <= 0) {
+                copied = false;
+                break;
+            }
+        }
+    }
+    close(source_fd);
+    if (copy_fd != -1) {
+        close(copy_fd);
+    }
+
+    if (copied) {
+        game_code.game_dll = dlopen(copy_path, RTLD_NOW | RTLD_LOCAL);
+    }
+    if (copy_fd != -1) {
+        unlink(copy_path);
+    }
+
+    if (game_code.game_dll) {
+        game_code.game_update_and_render =
+            (game_update_and_render*)dlsym(game_code.game_dll, "GameUpdateAndRender");
+        game_code.game_get_sound_samples =
+            (game_get_sound_samples*)dlsym(game_code.game_dll, "GameGetSoundSamples");
+        game_code.debug_game_frame_end =
+            (debug_game_frame_end*)dlsym(game_code.game_dll, "DEBUGGameFrameEnd");
+        game_code.is_valid = game_code.game_update_and_render && game_code.game_get_sound_samples;
+    }
     return game_code;
 }
+
+void unload_game_code(GameCode* game_code) {
+    if (game_code->game_dll) {
+        dlclose(game_code->game_dll);
+        game_code->game_dll = 0;
+    }
+    game_code->is_valid = false;
+    game_code->game_update_and_render = 0;
+    game_code->game_get_sound_samples = 0;
+    game_code->debug_game_frame_end = 0;
+}
+
+/// inotify on the library's directory, so we only see the file once the linker has closed it.
+/// Falls back to polling the modification time if inotify isn't available.
+struct GameCodeWatch {
+    char* source;
+    char* filename;
+    int inotify_fd;
+    // NOTE(sen) Set when a load failed (e.g. we raced a partial write), retried every frame until one works
+    bool32 reload_pending;
+};
+
+GameCodeWatch create_game_code_watch(char* source) {
+    GameCodeWatch watch = {};
+    watch.source = source;
+    watch.filename = strrchr(source, '/') ? strrchr(source, '/') + 1 : source;
+
+    char directory[PATH_MAX];
+    snprintf(directory, sizeof(directory), "%.*s", (int)(watch.filename - source), source);
+    if (directory[0] == '\0') {
+        directory[0] = '.';
+        directory[1] = '\0';
+    }
+
+    watch.inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch.inotify_fd != -1 && inotify_add_watch(watch.inotify_fd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        close(watch.inotify_fd);
+        watch.inotify_fd = -1;
+    }
+    return watch;
+}
+
+bool32 game_code_changed(GameCodeWatch* watch, GameCode* game_code) {
+    bool32 result = false;
+    if (watch->inotify_fd != -1) {
+        char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        ssize_t length;
+        while ((length = read(watch->inotify_fd, events, sizeof(events))) > 0) {
+            for (char* at = events; at < events + length;) {
+                struct inotify_event* event = (struct inotify_event*)at;
+                if (event->len && strcmp(event->name, watch->filename) == 0) {
+                    result = true;
+                }
+                at += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    } else {
+        timespec new_write_time = get_last_write_time(watch->source);
+        result = new_write_time.tv_sec != game_code->last_write_time.tv_sec ||
+            new_write_time.tv_nsec != game_code->last_write_time.tv_nsec;
+    }
+    result = result || watch->reload_pending;
+    return result;
+}
+
+#endif
@@ -1,12 +1,27 @@
 #include "../types.h"
 #include "window.cpp"
+#include "clock.cpp"
 #include "../game/lib.hpp"
 #include "stdlib.h"
 #include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 
+/// Two images so the game renders into one while the server reads the other
 struct X11GraphicsBuffer {
-    XImage* ximage;
-    game_offscreen_buffer game_buffer;
+    bool32 use_shm;
+    int32 shm_completion_event;
+    uint32 render_index;
+    XImage* ximages[2];
+    XShmSegmentInfo shm_infos[2];
+    bool32 present_pending[2];
+    game_offscreen_buffer game_buffers[2];
+
+    real32 last_present_seconds;
+    real32 total_present_seconds;
+    uint64 present_count;
 };
 
 void draw(void* rgb_out, int32 width, int32 height) {
@@ -17,30 +32,153 @@ void draw(void* rgb_out, int32 width, int32 height) {
     return;
 }
 
-X11GraphicsBuffer create_x11_graphics_buffer(X11Window* window, int32 width, int32 height) {
-    X11GraphicsBuffer buffer = {};
+global_variable bool32 global_shm_attach_failed;
 
-    buffer.game_buffer.BytesPerPixel = 4;
-    buffer.game_buffer.Height = height;
-    buffer.game_buffer.Width = width;
-    buffer.game_buffer.Pitch = width * buffer.game_buffer.BytesPerPixel;
-    buffer.game_buffer.Memory =
-        (uint8*)malloc(width * height * buffer.game_buffer.BytesPerPixel);
+int shm_attach_error_handler(Display* display, XErrorEvent* event) {
+    global_shm_attach_failed = true;
+    return 0;
+}
 
-    buffer.ximage = XCreateImage(
+bool32 create_shm_image(X11Window* window, X11GraphicsBuffer* buffer, uint32 index, int32 width, int32 height) {
+    XShmSegmentInfo* shm_info = buffer->shm_infos + index;
+    XImage* ximage = XShmCreateImage(
         window->display, window->visual, 24,
-        ZPixmap, 0, (char*)buffer.game_buffer.Memory,
-        width, height, 32, 0
+        ZPixmap, 0, shm_info, width, height
     );
+    if (!ximage) {
+        return false;
+    }
+
+    shm_info->shmid = shmget(IPC_PRIVATE, ximage->bytes_per_line * height, IPC_CREAT | 0600);
+    if (shm_info->shmid == -1) {
+        XDestroyImage(ximage);
+        return false;
+    }
+    shm_info->shmaddr = ximage->data = (char*)shmat(shm_info->shmid, 0, 0);
+    shm_info->readOnly = False;
+
+    // NOTE(sen) Attach fails asynchronously (e.g. on a remote display), so sync and check
+    global_shm_attach_failed = false;
+    XErrorHandler old_handler = XSetErrorHandler(shm_attach_error_handler);
+    XShmAttach(window->display, shm_info);
+    XSync(window->display, False);
+    XSetErrorHandler(old_handler);
+
+    // NOTE(sen) The segment goes away once both sides detach, including on a crash
+    shmctl(shm_info->shmid, IPC_RMID, 0);
+
+    if (global_shm_attach_failed || shm_info->shmaddr == (char*)-1) {
+        if (shm_info->shmaddr != (char*)-1) {
+            shmdt(shm_info->shmaddr);
+        }
+        ximage->data = 0;
+        XDestroyImage(ximage);
+        return false;
+    }
+
+    buffer->ximages[index] = ximage;
+    return true;
+}
+
+X11GraphicsBuffer create_x11_graphics_buffer(X11Window* window, int32 width, int32 height) {
+    X11GraphicsBuffer buffer = {};
+
+    buffer.use_shm = XShmQueryExtension(window->display);
+    if (buffer.use_shm) {
+        buffer.shm_completion_event = XShmGetEventBase(window->display) + ShmCompletion;
+        for (uint32 index = 0; index < ArrayCount(buffer.ximages) && buffer.use_shm; ++index) {
+            buffer.use_shm = create_shm_image(window, &buffer, index, width, height);
+        }
+        if (!buffer.use_shm) {
+            for (uint32 index = 0; index < ArrayCount(buffer.ximages); ++index) {
+                if (buffer.ximages[index]) {
+                    XShmDetach(window->display, buffer.shm_infos + index);
+                    shmdt(buffer.shm_infos[index].shmaddr);
+                    buffer.ximages[index]->data = 0;
+                    XDestroyImage(buffer.ximages[index]);
+                    buffer.ximages[index] = 0;
+                }
+            }
+        }
+    }
+
+    if (!buffer.use_shm) {
+        for (uint32 index = 0; index < ArrayCount(buffer.ximages); ++index) {
+            buffer.ximages[index] = XCreateImage(
+                window->display, window->visual, 24,
+                ZPixmap, 0, (char*)malloc(width * height * BITMAP_BYTES_PER_PIXEL),
+                width, height, 32, 0
+            );
+        }
+    }
+
+    for (uint32 index = 0; index < ArrayCount(buffer.ximages); ++index) {
+        game_offscreen_buffer* game_buffer = buffer.game_buffers + index;
+        game_buffer->Height = height;
+        game_buffer->Width = width;
+        game_buffer->Pitch = buffer.ximages[index]->bytes_per_line;
+        game_buffer->Memory = buffer.ximages[index]->data;
+    }
+
     return buffer;
 }
 
+game_offscreen_buffer* get_game_buffer(X11GraphicsBuffer* graphics_buffer) {
+    game_offscreen_buffer* result = graphics_buffer->game_buffers + graphics_buffer->render_index;
+    return result;
+}
+
+/// Pass every event from the main loop through here so shm completions are not lost
+void handle_x11_graphics_event(X11GraphicsBuffer* graphics_buffer, XEvent* event) {
+    if (graphics_buffer->use_shm && event->type == graphics_buffer->shm_completion_event) {
+        XShmCompletionEvent* completion = (XShmCompletionEvent*)event;
+        for (uint32 index = 0; index < ArrayCount(graphics_buffer->shm_infos); ++index) {
+            if (graphics_buffer->shm_infos[index].shmseg == completion->shmseg) {
+                graphics_buffer->present_pending[index] = false;
+            }
+        }
+    }
+}
+
+Bool is_shm_completion_event(Display* display, XEvent* event, XPointer arg) {
+    X11GraphicsBuffer* graphics_buffer = (X11GraphicsBuffer*)arg;
+    Bool result = event->type == graphics_buffer->shm_completion_event;
+    return result;
+}
+
 void display_x11_graphics_buffer(
     X11GraphicsBuffer* graphics_buffer, X11Window* window
 ) {
-    XPutImage(
-        window->display, window->window,
-        window->gc, graphics_buffer->ximage, 0, 0, 0, 0,
-        graphics_buffer->game_buffer.Width, graphics_buffer->game_buffer.Height
-    );
+    timespec present_start = linux_get_wall_clock();
+
+    uint32 present_index = graphics_buffer->render_index;
+    XImage* ximage = graphics_buffer->ximages[present_index];
+    if (graphics_buffer->use_shm) {
+        XShmPutImage(
+            window->display, window->window,
+            window->gc, ximage, 0, 0, 0, 0,
+            ximage->width, ximage->height, True
+        );
+        graphics_buffer->present_pending[present_index] = true;
+    } else {
+        XPutImage(
+            window->display, window->window,
+            window->gc, ximage, 0, 0, 0, 0,
+            ximage->width, ximage->height
+        );
+    }
+    XFlush(window->display);
+
+    // NOTE(sen) Can't render into the other buffer until the server is done reading it
+    uint32 next_render_index = (present_index + 1) % ArrayCount(graphics_buffer->ximages);
+    while (graphics_buffer->present_pending[next_render_index]) {
+        XEvent event;
+        XIfEvent(window->display, &event, is_shm_completion_event, (XPointer)graphics_buffer);
+        handle_x11_graphics_event(graphics_buffer, &event);
+    }
+    graphics_buffer->render_index = next_render_index;
+
+    graphics_buffer->last_present_seconds = linux_get_seconds_elapsed(present_start, linux_get_wall_clock());
+    graphics_buffer->total_present_seconds += graphics_buffer->last_present_seconds;
+    ++graphics_buffer->present_count;
 }
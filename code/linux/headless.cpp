@@ -0,0 +1,246 @@
+// NOTE(sen) Runs the game library without a display for benchmarking.
+// Usage: linux_headless [--frames=N] [--refresh=Hz] [--input=recording.hmi]
+//                       [--dump-frame=N]... [--dump-dir=dir] [linux settings]
+
+#include "../types.h"
+#include "gamecode.cpp"
+#include "settings.cpp"
+#include "workqueue.cpp"
+#include "file.cpp"
+#include "clock.cpp"
+#include "memory.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct HeadlessSettings {
+    uint32 frame_count;
+    char* input_path;
+    char* dump_directory;
+    uint32 dump_frame_count;
+    uint32 dump_frames[64];
+};
+
+HeadlessSettings parse_headless_settings(int argc, char** argv) {
+    HeadlessSettings settings = {};
+    settings.frame_count = 600;
+    settings.dump_directory = (char*)".";
+
+    for (int32 arg_index = 1; arg_index < argc; ++arg_index) {
+        char* arg = argv[arg_index];
+        char* value;
+        if ((value = match_setting(arg, (char*)"frames"))) {
+            settings.frame_count = (uint32)atoi(value);
+        } else if ((value = match_setting(arg, (char*)"input"))) {
+            settings.input_path = value;
+        } else if ((value = match_setting(arg, (char*)"dump-dir"))) {
+            settings.dump_directory = value;
+        } else if ((value = match_setting(arg, (char*)"dump-frame"))) {
+            if (settings.dump_frame_count < ArrayCount(settings.dump_frames)) {
+                settings.dump_frames[settings.dump_frame_count++] = (uint32)atoi(value);
+            }
+        }
+    }
+
+    return settings;
+}
+
+/// Holds Start on the first frame to spawn a hero, then walks it around in a square
+void make_synthetic_input(game_input* input, uint32 frame_index) {
+    game_controller_input* controller = GetController(input, 0);
+    controller->IsConnected = true;
+
+    game_controller_input old_controller = *controller;
+    for (uint32 button_index = 0; button_index < ArrayCount(controller->Buttons); ++button_index) {
+        controller->Buttons[button_index].EndedDown = false;
+    }
+
+    controller->Start.EndedDown = frame_index == 0;
+
+    real32 seconds = (real32)frame_index * input->dtForFrame;
+    switch ((uint32)(seconds / 2.0f) % 4) {
+    case 0: controller->MoveRight.EndedDown = true; break;
+    case 1: controller->MoveUp.EndedDown = true; break;
+    case 2: controller->MoveLeft.EndedDown = true; break;
+    case 3: controller->MoveDown.EndedDown = true; break;
+    }
+
+    for (uint32 button_index = 0; button_index < ArrayCount(controller->Buttons); ++button_index) {
+        game_button_state* button = controller->Buttons + button_index;
+        button->HalfTransitionCount = button->EndedDown != old_controller.Buttons[button_index].EndedDown;
+    }
+}
+
+/// Recordings are a flat sequence of game_input, loops back to the start at the end
+bool32 read_recorded_input(FILE* input_file, game_input* input) {
+    bool32 result = fread(input, sizeof(game_input), 1, input_file) == 1;
+    if (!result) {
+        rewind(input_file);
+        result = fread(input, sizeof(game_input), 1, input_file) == 1;
+    }
+    return result;
+}
+
+void dump_frame(game_offscreen_buffer* buffer, char* directory, uint32 frame_index) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/frame_%05u.ppm", directory, frame_index);
+    FILE* file = fopen(path, "wb");
+    if (file) {
+        fprintf(file, "P6\n%d %d\n255\n", buffer->Width, buffer->Height);
+        uint8* row = (uint8*)buffer->Memory;
+        uint8* rgb = (uint8*)malloc(buffer->Width * 3);
+        for (int32 y = 0; y < buffer->Height; ++y) {
+            uint32* pixel = (uint32*)row;
+            for (int32 x = 0; x < buffer->Width; ++x) {
+                rgb[x * 3 + 0] = (uint8)((pixel[x] >> 16) & 0xFF);
+                rgb[x * 3 + 1] = (uint8)((pixel[x] >> 8) & 0xFF);
+                rgb[x * 3 + 2] = (uint8)((pixel[x] >> 0) & 0xFF);
+            }
+            fwrite(rgb, buffer->Width * 3, 1, file);
+            row += buffer->Pitch;
+        }
+        free(rgb);
+        fclose(file);
+    } else {
+        fprintf(stderr, "could not write %s\n", path);
+    }
+}
+
+int compare_real32(const void* a, const void* b) {
+    real32 left = *(real32*)a;
+    real32 right = *(real32*)b;
+    int result = (left > right) - (left < right);
+    return result;
+}
+
+real32 percentile(real32* sorted, uint32 count, real32 fraction) {
+    uint32 index = (uint32)(fraction * (real32)(count - 1) + 0.5f);
+    real32 result = sorted[index];
+    return result;
+}
+
+int main(int argc, char** argv) {
+    LinuxSettings settings = parse_settings(argc, argv);
+    HeadlessSettings headless = parse_headless_settings(argc, argv);
+
+    GameCode game_code = load_game_code(settings.game_lib_path);
+    if (!game_code.game_update_and_render) {
+        fprintf(stderr, "could not load %s: %s\n", settings.game_lib_path, dlerror());
+        return 1;
+    }
+
+    FILE* input_file = 0;
+    if (headless.input_path) {
+        input_file = fopen(headless.input_path, "rb");
+        if (!input_file) {
+            fprintf(stderr, "could not open %s\n", headless.input_path);
+            return 1;
+        }
+    }
+
+    platform_work_queue high_priority_queue;
+    platform_work_queue low_priority_queue;
+    if (settings.pin_threads) {
+        linux_make_pinned_queues(
+            &high_priority_queue, settings.high_priority_thread_count,
+            &low_priority_queue, settings.low_priority_thread_count
+        );
+    } else {
+        linux_make_queue(&high_priority_queue, settings.high_priority_thread_count);
+        linux_make_queue(&low_priority_queue, settings.low_priority_thread_count);
+    }
+
+    game_memory game_memory = {};
+    game_memory.PermanentStorageSize = Megabytes(256);
+    game_memory.TransientStorageSize = Gigabytes(1);
+    game_memory.DebugStorageSize = Megabytes(64);
+    LinuxGameMemoryBlock memory_block = linux_allocate_game_memory(&game_memory, settings.huge_page_mode);
+    if (!memory_block.base) {
+        fprintf(stderr, "could not reserve %llu bytes of game memory\n", (unsigned long long)memory_block.size);
+        return 1;
+    }
+
+    game_memory.HighPriorityQueue = &high_priority_queue;
+    game_memory.LowPriorityQueue = &low_priority_queue;
+    game_memory.HighPriorityThreadCount = settings.high_priority_thread_count;
+    game_memory.PlatformAPI.AddEntry = linux_add_entry;
+    game_memory.PlatformAPI.CompleteAllWork = linux_complete_all_work;
+
+    linux_init_file_api(settings.data_directory, settings.map_asset_files);
+    game_memory.PlatformAPI.GetAllFilesOfTypeBegin = linux_get_all_files_of_type_begin;
+    game_memory.PlatformAPI.GetAllFilesOfTypeEnd = linux_get_all_files_of_type_end;
+    game_memory.PlatformAPI.OpenNextFile = linux_open_next_file;
+    game_memory.PlatformAPI.ReadDataFromFile = linux_read_data_from_file;
+    game_memory.PlatformAPI.FileError = linux_file_error;
+
+    // NOTE(sen) Same size as the Win32 back buffer
+    game_offscreen_buffer buffer = {};
+    buffer.Width = 1920;
+    buffer.Height = 1080;
+    buffer.Pitch = buffer.Width * BITMAP_BYTES_PER_PIXEL;
+    buffer.Memory = aligned_alloc(64, buffer.Pitch * buffer.Height);
+
+    real32 target_seconds_per_frame = 1.0f / settings.refresh_hz;
+
+    // NOTE(sen) The mixer works in chunks of 8 samples
+    game_sound_buffer sound_buffer = {};
+    sound_buffer.SamplesPerSecond = 48000;
+    sound_buffer.SampleCount = Align8((int32)((real32)sound_buffer.SamplesPerSecond * target_seconds_per_frame));
+    sound_buffer.Samples = (int16*)aligned_alloc(64, Align16(sound_buffer.SampleCount * 2 * sizeof(int16)));
+
+    game_input input = {};
+    real32* frame_seconds = (real32*)malloc(headless.frame_count * sizeof(real32));
+    real32 total_seconds = 0.0f;
+
+    for (uint32 frame_index = 0; frame_index < headless.frame_count; ++frame_index) {
+        if (input_file) {
+            read_recorded_input(input_file, &input);
+            input.ExecutableReloaded = false;
+        } else {
+            make_synthetic_input(&input, frame_index);
+        }
+        input.dtForFrame = target_seconds_per_frame;
+
+        timespec frame_start = linux_get_wall_clock();
+
+        game_code.game_update_and_render(&game_memory, &input, &buffer);
+        if (game_code.game_get_sound_samples) {
+            game_code.game_get_sound_samples(&game_memory, &sound_buffer);
+        }
+
+        frame_seconds[frame_index] = linux_get_seconds_elapsed(frame_start, linux_get_wall_clock());
+        total_seconds += frame_seconds[frame_index];
+        printf("frame %u: %.3fms\n", frame_index, frame_seconds[frame_index] * 1000.0f);
+
+        if (game_code.debug_game_frame_end) {
+            game_code.debug_game_frame_end(&game_memory);
+        }
+
+        for (uint32 dump_index = 0; dump_index < headless.dump_frame_count; ++dump_index) {
+            if (headless.dump_frames[dump_index] == frame_index) {
+                dump_frame(&buffer, headless.dump_directory, frame_index);
+            }
+        }
+    }
+
+    if (headless.frame_count > 0) {
+        qsort(frame_seconds, headless.frame_count, sizeof(real32), compare_real32);
+        printf(
+            "%u frames: mean %.3fms, min %.3fms, p50 %.3fms, p90 %.3fms, p99 %.3fms, max %.3fms\n",
+            headless.frame_count,
+            total_seconds * 1000.0f / (real32)headless.frame_count,
+            frame_seconds[0] * 1000.0f,
+            percentile(frame_seconds, headless.frame_count, 0.5f) * 1000.0f,
+            percentile(frame_seconds, headless.frame_count, 0.9f) * 1000.0f,
+            percentile(frame_seconds, headless.frame_count, 0.99f) * 1000.0f,
+            frame_seconds[headless.frame_count - 1] * 1000.0f
+        );
+        printf(
+            "resident %.1fMB of %.1fMB reserved\n",
+            (real32)linux_get_resident_bytes() / (real32)Megabytes(1),
+            (real32)memory_block.size / (real32)Megabytes(1)
+        );
+    }
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+#if !defined(INPUT_CPP)
+#define INPUT_CPP
+
+#include "../types.h"
+#include "../game/lib.hpp"
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+
+void process_keyboard_message(game_button_state* new_state, bool32 is_down) {
+    if (new_state->EndedDown != is_down) {
+        new_state->EndedDown = is_down;
+        ++new_state->HalfTransitionCount;
+    }
+}
+
+/// Keeps EndedDown from last frame, transitions are counted per frame
+void begin_input_frame(game_input* input) {
+    for (uint32 button_index = 0; button_index < ArrayCount(input->MouseButtons); ++button_index) {
+        input->MouseButtons[button_index].HalfTransitionCount = 0;
+    }
+    for (uint32 controller_index = 0; controller_index < ArrayCount(input->Controllers); ++controller_index) {
+        game_controller_input* controller = GetController(input, controller_index);
+        for (uint32 button_index = 0; button_index < ArrayCount(controller->Buttons); ++button_index) {
+            controller->Buttons[button_index].HalfTransitionCount = 0;
+        }
+    }
+    input->ExecutableReloaded = false;
+}
+
+/// Same bindings as Win32ProcessPendingMessages, returns the keysym so the caller can handle its own keys
+KeySym process_x11_key_event(XKeyEvent* event, game_controller_input* keyboard_controller) {
+    KeySym key = XLookupKeysym(event, 0);
+    bool32 is_down = event->type == KeyPress;
+    switch (key) {
+    case XK_w: process_keyboard_message(&keyboard_controller->MoveUp, is_down); break;
+    case XK_a: process_keyboard_message(&keyboard_controller->MoveLeft, is_down); break;
+    case XK_s: process_keyboard_message(&keyboard_controller->MoveDown, is_down); break;
+    case XK_d: process_keyboard_message(&keyboard_controller->MoveRight, is_down); break;
+    case XK_q: process_keyboard_message(&keyboard_controller->LeftShoulder, is_down); break;
+    case XK_e: process_keyboard_message(&keyboard_controller->RightShoulder, is_down); break;
+    case XK_Up: process_keyboard_message(&keyboard_controller->ActionUp, is_down); break;
+    case XK_Down: process_keyboard_message(&keyboard_controller->ActionDown, is_down); break;
+    case XK_Left: process_keyboard_message(&keyboard_controller->ActionLeft, is_down); break;
+    case XK_Right: process_keyboard_message(&keyboard_controller->ActionRight, is_down); break;
+    case XK_space: process_keyboard_message(&keyboard_controller->Start, is_down); break;
+    case XK_Escape: process_keyboard_message(&keyboard_controller->Back, is_down); break;
+    }
+    return key;
+}
+
+#endif
@@ -2,33 +2,157 @@
 #include "window.cpp"
 #include "graphics.cpp"
 #include "gamecode.cpp"
+#include "settings.cpp"
+#include "workqueue.cpp"
+#include "file.cpp"
+#include "clock.cpp"
+#include "memory.cpp"
+#include "input.cpp"
+#include "replay.cpp"
 #include <X11/Xlib.h>
 
-int main() {
+int main(int argc, char** argv) {
+    LinuxSettings settings = parse_settings(argc, argv);
+
+    platform_work_queue high_priority_queue;
+    platform_work_queue low_priority_queue;
+    if (settings.pin_threads) {
+        linux_make_pinned_queues(
+            &high_priority_queue, settings.high_priority_thread_count,
+            &low_priority_queue, settings.low_priority_thread_count
+        );
+    } else {
+        linux_make_queue(&high_priority_queue, settings.high_priority_thread_count);
+        linux_make_queue(&low_priority_queue, settings.low_priority_thread_count);
+    }
+
     uint32 width = 960;
     uint32 height = 540;
     X11Window window = create_window(width - 100, height);
     X11GraphicsBuffer graphics_buffer = create_x11_graphics_buffer(&window, width, height);
 
-    GameCode game_code = load_game_code();
-
-    thread_context thread = {};
+    GameCode game_code = load_game_code(settings.game_lib_path);
+    GameCodeWatch game_code_watch = create_game_code_watch(settings.game_lib_path);
 
     game_memory game_memory = {};
-    game_memory.PermanentStorageSize = Megabytes(64);
-    game_memory.PermanentStorage = malloc(game_memory.PermanentStorageSize);
+    game_memory.PermanentStorageSize = Megabytes(256);
+    game_memory.TransientStorageSize = Gigabytes(1);
+    game_memory.DebugStorageSize = Megabytes(64);
+    LinuxGameMemoryBlock memory_block = linux_allocate_game_memory(&game_memory, settings.huge_page_mode);
+    if (!memory_block.base) {
+        fprintf(stderr, "could not reserve %llu bytes of game memory\n", (unsigned long long)memory_block.size);
+        return 1;
+    }
+
+    game_memory.HighPriorityQueue = &high_priority_queue;
+    game_memory.LowPriorityQueue = &low_priority_queue;
+    game_memory.HighPriorityThreadCount = settings.high_priority_thread_count;
+    game_memory.PlatformAPI.AddEntry = linux_add_entry;
+    game_memory.PlatformAPI.CompleteAllWork = linux_complete_all_work;
+
+    linux_init_file_api(settings.data_directory, settings.map_asset_files);
+    game_memory.PlatformAPI.GetAllFilesOfTypeBegin = linux_get_all_files_of_type_begin;
+    game_memory.PlatformAPI.GetAllFilesOfTypeEnd = linux_get_all_files_of_type_end;
+    game_memory.PlatformAPI.OpenNextFile = linux_open_next_file;
+    game_memory.PlatformAPI.ReadDataFromFile = linux_read_data_from_file;
+    game_memory.PlatformAPI.FileError = linux_file_error;
+
+#if HANDMADE_INTERNAL
+    LinuxReplayState replay_state = create_replay_state(memory_block.base, memory_block.size);
+#endif
 
     game_input game_input = {};
 
+    FramePacer pacer = create_frame_pacer(settings.refresh_hz);
+    real32 target_seconds_per_frame = 1.0f / settings.refresh_hz;
+    game_input.dtForFrame = target_seconds_per_frame;
+
     for (;;) {
-        XEvent event;
-        XNextEvent(window.display, &event); // XCheckWindowEvent doesn't block
+        begin_input_frame(&game_input);
 
-        game_code.game_update_and_render(
-            &thread, &game_memory, &game_input, &graphics_buffer.game_buffer
-        );
+        if (game_code_changed(&game_code_watch, &game_code)) {
+            // NOTE(sen) Queued work can point at code in the old library
+            linux_complete_all_work(&high_priority_queue);
+            linux_complete_all_work(&low_priority_queue);
+
+            GameCode new_game_code = load_game_code(settings.game_lib_path);
+            if (new_game_code.is_valid) {
+                unload_game_code(&game_code);
+                game_code = new_game_code;
+                game_input.ExecutableReloaded = true;
+                game_code_watch.reload_pending = false;
+            } else {
+                unload_game_code(&new_game_code);
+                game_code_watch.reload_pending = true;
+            }
+        }
+        game_controller_input* keyboard_controller = GetController(&game_input, 0);
+        keyboard_controller->IsConnected = true;
+
+        while (XPending(window.display)) {
+            XEvent event;
+            XNextEvent(window.display, &event);
+            handle_x11_graphics_event(&graphics_buffer, &event);
+            if (event.type == KeyPress || event.type == KeyRelease) {
+                KeySym key = process_x11_key_event(&event.xkey, keyboard_controller);
+#if HANDMADE_INTERNAL
+                if (key == XK_l && event.type == KeyPress) {
+                    if (replay_state.input_playing_index == 0) {
+                        if (replay_state.input_recording_index == 0) {
+                            begin_recording_input(&replay_state, 1);
+                        } else {
+                            end_recording_input(&replay_state);
+                            begin_input_playback(&replay_state, 1);
+                        }
+                    } else {
+                        end_input_playback(&replay_state);
+                    }
+                    printf("loop snapshot/restore copied %.1fMB\n", (real32)replay_state.last_copied_bytes / (real32)Megabytes(1));
+                }
+#endif
+            }
+        }
+
+#if HANDMADE_INTERNAL
+        if (replay_state.input_recording_index) {
+            record_input(&replay_state, &game_input);
+        }
+        if (replay_state.input_playing_index) {
+            play_back_input(&replay_state, &game_input);
+        }
+#endif
+
+        if (game_code.game_update_and_render) {
+            game_code.game_update_and_render(&game_memory, &game_input, get_game_buffer(&graphics_buffer));
+        }
 
         display_x11_graphics_buffer(&graphics_buffer, &window);
+
+        real32 frame_seconds = wait_for_next_frame(&pacer);
+        // NOTE(sen) Don't let a long stall (debugger, reload) turn into one giant sim step
+        game_input.dtForFrame = Minimum(frame_seconds, 4.0f * target_seconds_per_frame);
+
+#if HANDMADE_INTERNAL
+        if (pacer.frame_count % 128 == 0) {
+            printf(
+                "frame %.3fms, missed %llu/%llu, sleep overshoot last %.3fms max %.3fms average %.3fms\n",
+                frame_seconds * 1000.0f,
+                (unsigned long long)pacer.missed_frame_count,
+                (unsigned long long)pacer.frame_count,
+                pacer.last_overshoot_seconds * 1000.0f,
+                pacer.max_overshoot_seconds * 1000.0f,
+                pacer.total_overshoot_seconds * 1000.0f /
+                    Maximum(1, pacer.frame_count - pacer.missed_frame_count)
+            );
+            printf(
+                "present (%s): last %.3fms, average %.3fms\n",
+                graphics_buffer.use_shm ? "shm" : "XPutImage",
+                graphics_buffer.last_present_seconds * 1000.0f,
+                graphics_buffer.total_present_seconds * 1000.0f / graphics_buffer.present_count
+            );
+            printf("resident %.1fMB\n", (real32)linux_get_resident_bytes() / (real32)Megabytes(1));
+        }
+#endif
     }
     return 0;
 }
@@ -0,0 +1,92 @@
+#if !defined(MEMORY_CPP)
+#define MEMORY_CPP
+
+#include "../types.h"
+#include "../game/lib.hpp"
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+enum HugePageMode {
+    HugePageMode_None,
+    HugePageMode_Transparent, // madvise(MADV_HUGEPAGE), falls back silently if THP is off
+    HugePageMode_Explicit, // MAP_HUGETLB, needs pages reserved in /proc/sys/vm/nr_hugepages
+};
+
+struct LinuxGameMemoryBlock {
+    void* base;
+    uint64 size;
+    HugePageMode huge_page_mode;
+};
+
+#define LINUX_HUGE_PAGE_SIZE Megabytes(2)
+
+/// One reservation for permanent, transient and debug storage, sizes are taken from memory.
+/// Anonymous mappings read as zero and only get physical pages when touched.
+LinuxGameMemoryBlock linux_allocate_game_memory(game_memory* memory, HugePageMode huge_page_mode) {
+    LinuxGameMemoryBlock block = {};
+    block.size = AlignPow2(
+        memory->PermanentStorageSize + memory->TransientStorageSize + memory->DebugStorageSize,
+        LINUX_HUGE_PAGE_SIZE
+    );
+    block.huge_page_mode = huge_page_mode;
+
+#if HANDMADE_INTERNAL
+    // NOTE(sen) Fixed address so that pointers in recorded game state stay valid between runs
+    void* base_address = (void*)Terabytes(2);
+    int fixed_flags = MAP_FIXED_NOREPLACE;
+#else
+    void* base_address = 0;
+    int fixed_flags = 0;
+#endif
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | fixed_flags;
+    block.base = MAP_FAILED;
+    if (huge_page_mode == HugePageMode_Explicit) {
+        // NOTE(sen) No MAP_NORESERVE here, so we fail now instead of SIGBUS on first touch when the pool is short
+        block.base = mmap(
+            base_address, block.size, PROT_READ | PROT_WRITE, (flags & ~MAP_NORESERVE) | MAP_HUGETLB, -1, 0
+        );
+        if (block.base == MAP_FAILED) {
+            fprintf(stderr, "MAP_HUGETLB failed, falling back to transparent huge pages\n");
+            block.huge_page_mode = HugePageMode_Transparent;
+        }
+    }
+    if (block.base == MAP_FAILED) {
+        block.base = mmap(base_address, block.size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    }
+    if (block.base == MAP_FAILED && fixed_flags) {
+        block.base = mmap(0, block.size, PROT_READ | PROT_WRITE, flags & ~fixed_flags, -1, 0);
+    }
+    if (block.base == MAP_FAILED) {
+        block.base = 0;
+        return block;
+    }
+
+    if (block.huge_page_mode == HugePageMode_Transparent) {
+        madvise(block.base, block.size, MADV_HUGEPAGE);
+    }
+
+    memory->PermanentStorage = block.base;
+    memory->TransientStorage = (uint8*)memory->PermanentStorage + memory->PermanentStorageSize;
+    memory->DebugStorage = (uint8*)memory->TransientStorage + memory->TransientStorageSize;
+
+    return block;
+}
+
+/// Whole process resident set, from /proc/self/statm
+uint64 linux_get_resident_bytes() {
+    uint64 result = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm) {
+        unsigned long long total_pages;
+        unsigned long long resident_pages;
+        if (fscanf(statm, "%llu %llu", &total_pages, &resident_pages) == 2) {
+            result = (uint64)resident_pages * (uint64)sysconf(_SC_PAGESIZE);
+        }
+        fclose(statm);
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,241 @@
+#if !defined(REPLAY_CPP)
+#define REPLAY_CPP
+
+#include "../types.h"
+#include "../game/lib.hpp"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// NOTE(sen) Looped live editing like win32_replay_buffer. State snapshots live in memfds
+// instead of files, and we only copy pages that are resident when we take a snapshot and
+// pages the kernel's soft-dirty bits say changed when we restore one.
+
+struct ReplayBuffer {
+    int memfd;
+    uint8* memory_block;
+};
+
+struct LinuxReplayState {
+    uint8* game_memory_block;
+    uint64 total_size;
+    uint64 page_size;
+    ReplayBuffer replay_buffers[4];
+
+    // NOTE(sen) Set once clear_refs has worked, we then trust soft-dirty bits since the last snapshot/restore
+    bool32 soft_dirty_supported;
+    bool32 soft_dirty_tracking;
+    int pagemap_fd;
+
+    FILE* recording_file;
+    int32 input_recording_index;
+
+    FILE* playing_file;
+    int32 input_playing_index;
+
+    uint64 last_copied_bytes;
+};
+
+/// Resets the soft-dirty bit of every page in the process
+bool32 clear_soft_dirty_bits() {
+    bool32 result = false;
+    int fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+    if (fd != -1) {
+        result = write(fd, "4", 1) == 1;
+        close(fd);
+    }
+    return result;
+}
+
+uint64 read_pagemap_entry(int pagemap_fd, void* address) {
+    uint64 entry = 0;
+    off_t offset = (off_t)(((uint64)address / (uint64)sysconf(_SC_PAGESIZE)) * sizeof(uint64));
+    if (pread(pagemap_fd, &entry, sizeof(entry), offset) != sizeof(entry)) {
+        entry = 0;
+    }
+    return entry;
+}
+
+/// Kernels without CONFIG_MEM_SOFT_DIRTY accept clear_refs but never set the bit, so try it on a scratch page
+bool32 probe_soft_dirty(int pagemap_fd) {
+    bool32 result = false;
+    void* page = mmap(0, (size_t)sysconf(_SC_PAGESIZE), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (page != MAP_FAILED) {
+        *(uint8 volatile*)page = 1;
+        if (clear_soft_dirty_bits()) {
+            bool32 clean_after_clear = !((read_pagemap_entry(pagemap_fd, page) >> 55) & 1);
+            *(uint8 volatile*)page = 2;
+            bool32 dirty_after_write = (read_pagemap_entry(pagemap_fd, page) >> 55) & 1;
+            result = clean_after_clear && dirty_after_write;
+        }
+        munmap(page, (size_t)sysconf(_SC_PAGESIZE));
+    }
+    return result;
+}
+
+LinuxReplayState create_replay_state(void* game_memory_block, uint64 total_size) {
+    LinuxReplayState state = {};
+    state.game_memory_block = (uint8*)game_memory_block;
+    state.total_size = total_size;
+    state.page_size = (uint64)sysconf(_SC_PAGESIZE);
+    state.pagemap_fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    state.soft_dirty_supported = state.pagemap_fd != -1 && probe_soft_dirty(state.pagemap_fd);
+    return state;
+}
+
+void get_input_file_location(int32 slot_index, size_t dest_count, char* dest) {
+    snprintf(dest, dest_count, "loop_edit_%d_input.hmi", slot_index);
+}
+
+ReplayBuffer* get_replay_buffer(LinuxReplayState* state, int32 index) {
+    Assert(index < (int32)ArrayCount(state->replay_buffers));
+    ReplayBuffer* buffer = state->replay_buffers + index;
+    if (!buffer->memory_block) {
+        char name[64];
+        snprintf(name, sizeof(name), "loop_edit_%d_state", index);
+        buffer->memfd = memfd_create(name, MFD_CLOEXEC);
+        if (buffer->memfd != -1 && ftruncate(buffer->memfd, state->total_size) == 0) {
+            void* mapped = mmap(0, state->total_size, PROT_READ | PROT_WRITE, MAP_SHARED, buffer->memfd, 0);
+            if (mapped != MAP_FAILED) {
+                buffer->memory_block = (uint8*)mapped;
+            }
+        }
+    }
+    return buffer->memory_block ? buffer : 0;
+}
+
+/// Copies the pages that are resident in the game block, everything else was never touched
+uint64 copy_resident_pages(LinuxReplayState* state, uint8* dest, uint8* source) {
+    uint64 copied_bytes = 0;
+    uint64 page_count = state->total_size / state->page_size;
+    uint8 residency[4096];
+    for (uint64 first_page = 0; first_page < page_count; first_page += sizeof(residency)) {
+        uint64 batch_count = Minimum(sizeof(residency), page_count - first_page);
+        uint64 batch_offset = first_page * state->page_size;
+        if (mincore(state->game_memory_block + batch_offset, batch_count * state->page_size, residency) != 0) {
+            memset(residency, 1, batch_count);
+        }
+        for (uint64 page_index = 0; page_index < batch_count;) {
+            if (residency[page_index] & 1) {
+                uint64 run_start = page_index;
+                while (page_index < batch_count && (residency[page_index] & 1)) {
+                    ++page_index;
+                }
+                uint64 offset = batch_offset + run_start * state->page_size;
+                uint64 size = (page_index - run_start) * state->page_size;
+                memcpy(dest + offset, source + offset, size);
+                copied_bytes += size;
+            } else {
+                ++page_index;
+            }
+        }
+    }
+    return copied_bytes;
+}
+
+void take_snapshot(LinuxReplayState* state, ReplayBuffer* buffer) {
+    // NOTE(sen) Punch out the previous snapshot so pages we don't copy read back as zero
+    fallocate(buffer->memfd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, 0, state->total_size);
+
+    state->last_copied_bytes = copy_resident_pages(state, buffer->memory_block, state->game_memory_block);
+
+    state->soft_dirty_tracking = state->soft_dirty_supported && clear_soft_dirty_bits();
+}
+
+void restore_snapshot(LinuxReplayState* state, ReplayBuffer* buffer) {
+    state->last_copied_bytes = 0;
+    if (state->soft_dirty_tracking) {
+        uint64 page_count = state->total_size / state->page_size;
+        uint64 first_page_in_process = (uint64)state->game_memory_block / state->page_size;
+        uint64 entries[4096];
+        for (uint64 first_page = 0; first_page < page_count; first_page += ArrayCount(entries)) {
+            uint64 batch_count = Minimum(ArrayCount(entries), page_count - first_page);
+            off_t pagemap_offset = (off_t)((first_page_in_process + first_page) * sizeof(uint64));
+            ssize_t bytes_read = pread(state->pagemap_fd, entries, batch_count * sizeof(uint64), pagemap_offset);
+            if (bytes_read != (ssize_t)(batch_count * sizeof(uint64))) {
+                // NOTE(sen) Can't tell what changed, copy the whole batch
+                uint64 offset = first_page * state->page_size;
+                memcpy(state->game_memory_block + offset, buffer->memory_block + offset, batch_count * state->page_size);
+                state->last_copied_bytes += batch_count * state->page_size;
+                continue;
+            }
+            for (uint64 page_index = 0; page_index < batch_count; ++page_index) {
+                bool32 soft_dirty = (entries[page_index] >> 55) & 1;
+                if (soft_dirty) {
+                    uint64 offset = (first_page + page_index) * state->page_size;
+                    memcpy(state->game_memory_block + offset, buffer->memory_block + offset, state->page_size);
+                    state->last_copied_bytes += state->page_size;
+                }
+            }
+        }
+        state->soft_dirty_tracking = clear_soft_dirty_bits();
+    } else {
+        state->last_copied_bytes = copy_resident_pages(state, state->game_memory_block, buffer->memory_block);
+    }
+}
+
+void begin_recording_input(LinuxReplayState* state, int32 input_recording_index) {
+    ReplayBuffer* buffer = get_replay_buffer(state, input_recording_index);
+    if (!buffer) {
+        return;
+    }
+
+    char filename[64];
+    get_input_file_location(input_recording_index, sizeof(filename), filename);
+    state->recording_file = fopen(filename, "wb");
+    if (!state->recording_file) {
+        return;
+    }
+    state->input_recording_index = input_recording_index;
+
+    take_snapshot(state, buffer);
+}
+
+void end_recording_input(LinuxReplayState* state) {
+    fclose(state->recording_file);
+    state->recording_file = 0;
+    state->input_recording_index = 0;
+}
+
+void begin_input_playback(LinuxReplayState* state, int32 input_playing_index) {
+    ReplayBuffer* buffer = get_replay_buffer(state, input_playing_index);
+    if (!buffer) {
+        return;
+    }
+
+    char filename[64];
+    get_input_file_location(input_playing_index, sizeof(filename), filename);
+    state->playing_file = fopen(filename, "rb");
+    if (!state->playing_file) {
+        return;
+    }
+    state->input_playing_index = input_playing_index;
+
+    restore_snapshot(state, buffer);
+}
+
+void end_input_playback(LinuxReplayState* state) {
+    fclose(state->playing_file);
+    state->playing_file = 0;
+    state->input_playing_index = 0;
+}
+
+void record_input(LinuxReplayState* state, game_input* new_input) {
+    fwrite(new_input, sizeof(*new_input), 1, state->recording_file);
+}
+
+void play_back_input(LinuxReplayState* state, game_input* new_input) {
+    if (fread(new_input, sizeof(*new_input), 1, state->playing_file) != 1) {
+        int32 playing_index = state->input_playing_index;
+        end_input_playback(state);
+        begin_input_playback(state, playing_index);
+        if (state->playing_file) {
+            fread(new_input, sizeof(*new_input), 1, state->playing_file);
+        }
+    }
+}
+
+#endif
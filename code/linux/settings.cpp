@@ -0,0 +1,83 @@
+#if !defined(SETTINGS_CPP)
+#define SETTINGS_CPP
+
+#include "../types.h"
+#include "memory.cpp"
+#include "gamecode.cpp"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct LinuxSettings {
+    uint32 high_priority_thread_count;
+    uint32 low_priority_thread_count;
+    char* data_directory;
+    bool32 map_asset_files;
+    char game_lib_path[PATH_MAX];
+    real32 refresh_hz;
+    HugePageMode huge_page_mode;
+    bool32 pin_threads;
+};
+
+// NOTE(sen) Matches "--name=value", returns the value part or 0
+char* match_setting(char* arg, char* name) {
+    char* result = 0;
+    size_t name_length = strlen(name);
+    if (strncmp(arg, "--", 2) == 0 && strncmp(arg + 2, name, name_length) == 0 && arg[2 + name_length] == '=') {
+        result = arg + 2 + name_length + 1;
+    }
+    return result;
+}
+
+LinuxSettings parse_settings(int argc, char** argv) {
+    LinuxSettings settings = {};
+
+    settings.low_priority_thread_count = 2;
+    settings.data_directory = (char*)".";
+    build_exe_path_filename((char*)"game_lib.so", sizeof(settings.game_lib_path), settings.game_lib_path);
+    settings.refresh_hz = 30.0f;
+    settings.pin_threads = true;
+
+    for (int32 arg_index = 1; arg_index < argc; ++arg_index) {
+        char* arg = argv[arg_index];
+        char* value;
+        if ((value = match_setting(arg, (char*)"high-threads"))) {
+            settings.high_priority_thread_count = (uint32)atoi(value);
+        } else if ((value = match_setting(arg, (char*)"low-threads"))) {
+            settings.low_priority_thread_count = (uint32)atoi(value);
+        } else if ((value = match_setting(arg, (char*)"data-dir"))) {
+            settings.data_directory = value;
+        } else if ((value = match_setting(arg, (char*)"game-lib"))) {
+            snprintf(settings.game_lib_path, sizeof(settings.game_lib_path), "%s", value);
+        } else if ((value = match_setting(arg, (char*)"refresh"))) {
+            // NOTE(sen) Keeps the default if the value is 0, negative or not a number, the pacer divides by it
+            real32 refresh_hz = (real32)atof(value);
+            if (refresh_hz > 0.0f) {
+                settings.refresh_hz = refresh_hz < 1000.0f ? refresh_hz : 1000.0f;
+            }
+        } else if ((value = match_setting(arg, (char*)"huge-pages"))) {
+            if (strcmp(value, "thp") == 0) {
+                settings.huge_page_mode = HugePageMode_Transparent;
+            } else if (strcmp(value, "hugetlb") == 0) {
+                settings.huge_page_mode = HugePageMode_Explicit;
+            }
+        } else if (strcmp(arg, "--mmap-assets") == 0) {
+            settings.map_asset_files = true;
+        } else if (strcmp(arg, "--no-pin-threads") == 0) {
+            settings.pin_threads = false;
+        }
+    }
+
+    // NOTE(sen) The main thread also does work while it waits in CompleteAllWork. Pinned I/O
+    // workers get cpus of their own, so leave those out too.
+    if (settings.high_priority_thread_count == 0) {
+        int32 processor_count = (int32)sysconf(_SC_NPROCESSORS_ONLN);
+        int32 reserved_count = 1 + (settings.pin_threads ? (int32)settings.low_priority_thread_count : 0);
+        settings.high_priority_thread_count = processor_count > reserved_count + 1 ? processor_count - reserved_count : 1;
+    }
+
+    return settings;
+}
+
+#endif
@@ -0,0 +1,170 @@
+#if !defined(TOPOLOGY_CPP)
+#define TOPOLOGY_CPP
+
+#include "../types.h"
+#include "../util.h"
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LOGICAL_CPU_COUNT 1024
+
+struct LogicalCpu {
+    int32 index;
+    int32 core_id;
+    int32 package_id;
+    int32 node_id;
+};
+
+/// CPUs we're allowed to run on, sorted by node, package and core so SMT siblings are adjacent
+struct CpuTopology {
+    uint32 cpu_count;
+    LogicalCpu cpus[MAX_LOGICAL_CPU_COUNT];
+};
+
+int32 read_sysfs_int(char* path) {
+    int32 result = -1;
+    FILE* file = fopen(path, "r");
+    if (file) {
+        if (fscanf(file, "%d", &result) != 1) {
+            result = -1;
+        }
+        fclose(file);
+    }
+    return result;
+}
+
+int32 read_cpu_node(int32 cpu_index) {
+    int32 result = 0;
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu_index);
+    DIR* dir = opendir(path);
+    if (dir) {
+        struct dirent* entry;
+        while ((entry = readdir(dir))) {
+            if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+                result = atoi(entry->d_name + 4);
+                break;
+            }
+        }
+        closedir(dir);
+    }
+    return result;
+}
+
+int compare_logical_cpus(const void* a_init, const void* b_init) {
+    LogicalCpu* a = (LogicalCpu*)a_init;
+    LogicalCpu* b = (LogicalCpu*)b_init;
+    int result = a->node_id != b->node_id ? a->node_id - b->node_id :
+        a->package_id != b->package_id ? a->package_id - b->package_id :
+        a->core_id != b->core_id ? a->core_id - b->core_id :
+        a->index - b->index;
+    return result;
+}
+
+CpuTopology* read_cpu_topology() {
+    CpuTopology* topology = (CpuTopology*)calloc(1, sizeof(CpuTopology));
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return topology;
+    }
+
+    for (int32 cpu_index = 0; cpu_index < CPU_SETSIZE && topology->cpu_count < MAX_LOGICAL_CPU_COUNT; ++cpu_index) {
+        if (CPU_ISSET(cpu_index, &allowed)) {
+            LogicalCpu* cpu = topology->cpus + topology->cpu_count++;
+            cpu->index = cpu_index;
+
+            char path[128];
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu_index);
+            cpu->core_id = read_sysfs_int(path);
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu_index);
+            cpu->package_id = read_sysfs_int(path);
+            cpu->node_id = read_cpu_node(cpu_index);
+
+            // NOTE(sen) No topology info, treat every logical cpu as its own core
+            if (cpu->core_id == -1) {
+                cpu->core_id = cpu_index;
+            }
+        }
+    }
+
+    qsort(topology->cpus, topology->cpu_count, sizeof(LogicalCpu), compare_logical_cpus);
+    return topology;
+}
+
+/// -1 means don't pin
+struct ThreadPlacement {
+    int32 main_cpu;
+    int32 high_priority_cpus[MAX_LOGICAL_CPU_COUNT];
+    int32 low_priority_cpus[MAX_LOGICAL_CPU_COUNT];
+};
+
+/// The main thread and the render workers take consecutive logical cpus from the start of the
+/// sorted list, so they fill whole cores (both SMT siblings) on one node before spilling over.
+/// The I/O workers take the cpus after that so they don't steal time from rendering. Threads that
+/// don't get a cpu of their own are left to the scheduler rather than stacked on a busy one.
+void plan_thread_placement(
+    CpuTopology* topology, uint32 high_priority_count, uint32 low_priority_count, ThreadPlacement* placement
+) {
+    for (uint32 index = 0; index < MAX_LOGICAL_CPU_COUNT; ++index) {
+        placement->high_priority_cpus[index] = -1;
+        placement->low_priority_cpus[index] = -1;
+    }
+    placement->main_cpu = -1;
+    if (topology->cpu_count == 0) {
+        return;
+    }
+
+    uint32 next_cpu = 0;
+    placement->main_cpu = topology->cpus[next_cpu++].index;
+    for (uint32 index = 0; index < Minimum(high_priority_count, MAX_LOGICAL_CPU_COUNT); ++index) {
+        if (next_cpu < topology->cpu_count) {
+            placement->high_priority_cpus[index] = topology->cpus[next_cpu++].index;
+        }
+    }
+
+    // NOTE(sen) I/O mostly waits on the disk, so the workers can share whatever is left
+    uint32 io_cpu_count = topology->cpu_count - next_cpu;
+    if (io_cpu_count > 0) {
+        for (uint32 index = 0; index < Minimum(low_priority_count, MAX_LOGICAL_CPU_COUNT); ++index) {
+            placement->low_priority_cpus[index] = topology->cpus[next_cpu + index % io_cpu_count].index;
+        }
+    }
+}
+
+void pin_current_thread(int32 cpu) {
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+}
+
+#if HANDMADE_INTERNAL
+void print_thread_placement(
+    CpuTopology* topology, uint32 high_priority_count, uint32 low_priority_count, ThreadPlacement* placement
+) {
+    printf("cpus:");
+    for (uint32 cpu_index = 0; cpu_index < topology->cpu_count; ++cpu_index) {
+        LogicalCpu* cpu = topology->cpus + cpu_index;
+        printf(" %d(node %d core %d)", cpu->index, cpu->node_id, cpu->core_id);
+    }
+    printf("\nmain on %d, render on", placement->main_cpu);
+    for (uint32 index = 0; index < high_priority_count; ++index) {
+        printf(" %d", placement->high_priority_cpus[index]);
+    }
+    printf(", io on");
+    for (uint32 index = 0; index < low_priority_count; ++index) {
+        printf(" %d", placement->low_priority_cpus[index]);
+    }
+    printf("\n");
+}
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "../types.h"
 #include <X11/Xlib.h>
+#include <X11/XKBlib.h>
 
 struct X11Window {
     Display* display;
@@ -24,7 +25,9 @@ X11Window create_window(uint32 width, uint32 height) {
         window.display, root_window, 0, 0, width, height, 0,
         blackColor, blackColor
     );
-    XSelectInput(window.display, window.window, ExposureMask | ButtonPressMask | KeyPressMask);
+    XSelectInput(window.display, window.window, ExposureMask | ButtonPressMask | KeyPressMask | KeyReleaseMask);
+    // NOTE(sen) Otherwise a held key sends release/press pairs
+    XkbSetDetectableAutoRepeat(window.display, True, 0);
     XMapWindow(window.display, window.window);
 
     window.gc = XCreateGC(window.display, window.window, 0, 0);
@@ -0,0 +1,132 @@
+#if !defined(WORKQUEUE_CPP)
+#define WORKQUEUE_CPP
+
+#include "../types.h"
+#include "../game/lib.hpp"
+#include "topology.cpp"
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+
+struct WorkQueueEntry {
+    platform_work_queue_callback* callback;
+    void* data;
+};
+
+struct platform_work_queue {
+    uint32 volatile completion_goal;
+    uint32 volatile completion_count;
+    uint32 volatile next_entry_to_write;
+    uint32 volatile next_entry_to_read;
+    sem_t semaphore;
+    WorkQueueEntry entries[256];
+};
+
+/// Single producer - one thread calls this
+void linux_add_entry(platform_work_queue* queue, platform_work_queue_callback* callback, void* data) {
+    uint32 new_next_entry_to_write = (queue->next_entry_to_write + 1) % ArrayCount(queue->entries);
+    Assert(new_next_entry_to_write != queue->next_entry_to_read);
+    WorkQueueEntry* entry = queue->entries + queue->next_entry_to_write;
+    entry->data = data;
+    entry->callback = callback;
+    ++queue->completion_goal;
+    CompletePreviousWritesBeforeFutureWrites;
+    queue->next_entry_to_write = new_next_entry_to_write;
+    sem_post(&queue->semaphore);
+}
+
+bool32 linux_do_next_work_queue_entry(platform_work_queue* queue) {
+    bool32 should_sleep = false;
+    uint32 original_next_entry_to_read = queue->next_entry_to_read;
+    uint32 new_next_entry_to_read = (original_next_entry_to_read + 1) % ArrayCount(queue->entries);
+    if (original_next_entry_to_read != queue->next_entry_to_write) {
+        uint32 index = AtomicCompareExchangeUint32(
+            &queue->next_entry_to_read, new_next_entry_to_read, original_next_entry_to_read
+        );
+        if (index == original_next_entry_to_read) {
+            WorkQueueEntry entry = queue->entries[index];
+            entry.callback(queue, entry.data);
+            AtomicAddU32(&queue->completion_count, 1);
+        }
+    } else {
+        should_sleep = true;
+    }
+    return should_sleep;
+}
+
+void linux_complete_all_work(platform_work_queue* queue) {
+    while (queue->completion_goal != queue->completion_count) {
+        linux_do_next_work_queue_entry(queue);
+    }
+    queue->completion_count = 0;
+    queue->completion_goal = 0;
+}
+
+void* work_queue_thread_proc(void* param) {
+    platform_work_queue* queue = (platform_work_queue*)param;
+    for (;;) {
+        if (linux_do_next_work_queue_entry(queue)) {
+            // NOTE(sen) Retry on EINTR, a signal is not a wakeup
+            while (sem_wait(&queue->semaphore) != 0) {}
+        }
+    }
+    return 0;
+}
+
+/// thread_cpus has a logical cpu per thread to pin it to (-1 leaves it to the scheduler), or is 0 to pin none
+void linux_make_queue(platform_work_queue* queue, uint32 thread_count, int32* thread_cpus = 0) {
+    queue->completion_count = 0;
+    queue->completion_goal = 0;
+    queue->next_entry_to_read = 0;
+    queue->next_entry_to_write = 0;
+    uint32 initial_count = 0;
+    sem_init(&queue->semaphore, 0, initial_count);
+
+    for (uint32 thread_index = 0; thread_index < thread_count; ++thread_index) {
+        int32 cpu = thread_cpus ? thread_cpus[thread_index] : -1;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+        }
+        pthread_t thread;
+        if (pthread_create(&thread, &attr, work_queue_thread_proc, queue) != 0 && cpu >= 0) {
+            // NOTE(sen) The cpu may have gone offline since we read the topology, run unpinned
+            pthread_attr_destroy(&attr);
+            pthread_attr_init(&attr);
+            pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+            pthread_create(&thread, &attr, work_queue_thread_proc, queue);
+        }
+        pthread_attr_destroy(&attr);
+    }
+}
+
+/// Render workers on whole cores of one node with the main thread, I/O workers off to the side
+void linux_make_pinned_queues(
+    platform_work_queue* high_priority_queue, uint32 high_priority_count,
+    platform_work_queue* low_priority_queue, uint32 low_priority_count
+) {
+    high_priority_count = Minimum(high_priority_count, MAX_LOGICAL_CPU_COUNT);
+    low_priority_count = Minimum(low_priority_count, MAX_LOGICAL_CPU_COUNT);
+
+    CpuTopology* topology = read_cpu_topology();
+    ThreadPlacement* placement = (ThreadPlacement*)malloc(sizeof(ThreadPlacement));
+    plan_thread_placement(topology, high_priority_count, low_priority_count, placement);
+#if HANDMADE_INTERNAL
+    print_thread_placement(topology, high_priority_count, low_priority_count, placement);
+#endif
+
+    // NOTE(sen) Threads we don't pin inherit our affinity, so the main thread goes last
+    linux_make_queue(high_priority_queue, high_priority_count, placement->high_priority_cpus);
+    linux_make_queue(low_priority_queue, low_priority_count, placement->low_priority_cpus);
+    pin_current_thread(placement->main_cpu);
+
+    free(placement);
+    free(topology);
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "intrinsics.h"
 #include "file_formats.h"
 #include "game/math.cpp"
+#include "game/mip.cpp"
 
 #define USE_FONTS_FROM_WINDOWS 1
 
@@ -719,6 +720,56 @@ LoadWAV(char* Filename, uint32 SectionFirstSampleIndex, uint32 SectionSampleCoun
     return Result;
     }
 
+/// Which texels of the full size level are transparent/opaque, so the renderer can skip them
+internal void WriteBitmapCoverage(loaded_bitmap* Bitmap, FILE* Out) {
+    hha_bitmap_coverage Coverage = {};
+    Coverage.TrimMin[0] = (uint16)Bitmap->Width;
+    Coverage.TrimMin[1] = (uint16)Bitmap->Height;
+    Coverage.Flags = HHABitmap_Opaque;
+
+    uint32 SpansSize = Bitmap->Height * sizeof(hha_bitmap_row_span);
+    hha_bitmap_row_span* Spans = (hha_bitmap_row_span*)malloc(SpansSize);
+    for (int32 Y = 0; Y < Bitmap->Height; ++Y) {
+        uint32* Row = (uint32*)((uint8*)Bitmap->Memory + Y * Bitmap->Pitch);
+        hha_bitmap_row_span* Span = Spans + Y;
+        *Span = {};
+        Span->MinX = (uint16)Bitmap->Width;
+        int32 RunMinX = 0;
+        for (int32 X = 0; X < Bitmap->Width; ++X) {
+            uint32 Alpha = Row[X] >> 24;
+            if (Alpha) {
+                Span->MinX = (uint16)Minimum(Span->MinX, X);
+                Span->MaxX = (uint16)(X + 1);
+            }
+            if (Alpha == 0xFF) {
+                if (X + 1 - RunMinX > Span->OpaqueMaxX - Span->OpaqueMinX) {
+                    Span->OpaqueMinX = (uint16)RunMinX;
+                    Span->OpaqueMaxX = (uint16)(X + 1);
+                }
+            } else {
+                RunMinX = X + 1;
+                Coverage.Flags &= ~HHABitmap_Opaque;
+            }
+        }
+        if (Span->MaxX) {
+            Coverage.TrimMin[0] = Minimum(Coverage.TrimMin[0], Span->MinX);
+            Coverage.TrimMax[0] = Maximum(Coverage.TrimMax[0], Span->MaxX);
+            Coverage.TrimMin[1] = Minimum(Coverage.TrimMin[1], (uint16)Y);
+            Coverage.TrimMax[1] = (uint16)(Y + 1);
+        } else {
+            Span->MinX = 0;
+        }
+    }
+    if (Coverage.TrimMax[0] == 0) {
+        Coverage.TrimMin[0] = 0;
+        Coverage.TrimMin[1] = 0;
+    }
+
+    fwrite(&Coverage, sizeof(Coverage), 1, Out);
+    fwrite(Spans, SpansSize, 1, Out);
+    free(Spans);
+}
+
 internal void WriteHHA(game_assets* Assets, char* Filename) {
     FILE* Out = fopen(Filename, "wb");
     if (Out) {
@@ -780,9 +831,17 @@ internal void WriteHHA(game_assets* Assets, char* Filename) {
                 }
                 Dest->Bitmap.Dim[0] = Bitmap.Width;
                 Dest->Bitmap.Dim[1] = Bitmap.Height;
+                Dest->Bitmap.MipCount = GetMipCount(Bitmap.Width, Bitmap.Height);
 
                 Assert(Bitmap.Width * 4 == Bitmap.Pitch);
-                fwrite(Bitmap.Memory, Bitmap.Height * Bitmap.Width * BITMAP_BYTES_PER_PIXEL, 1, Out);
+                uint32 ChainSize =
+                    GetMipChainTexelCount(Bitmap.Width, Bitmap.Height, Dest->Bitmap.MipCount) * BITMAP_BYTES_PER_PIXEL;
+                uint32* Chain = (uint32*)malloc(ChainSize);
+                memcpy(Chain, Bitmap.Memory, Bitmap.Height * Bitmap.Width * BITMAP_BYTES_PER_PIXEL);
+                BuildMipChain(Chain, Bitmap.Width, Bitmap.Height, Dest->Bitmap.MipCount);
+                fwrite(Chain, ChainSize, 1, Out);
+                free(Chain);
+                WriteBitmapCoverage(&Bitmap, Out);
                 free(Bitmap.Free);
             }
 
@@ -1,6 +1,7 @@
 #if !defined(HANDMADE_TYPES_H)
 #define HANDMADE_TYPES_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <float.h>
 
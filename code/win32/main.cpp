@@ -1054,8 +1054,9 @@ int CALLBACK WinMain(HINSTANCE Instance, HINSTANCE PrevInstance, LPSTR CommandLi
 
     win32_state Win32State = {};
 
+    uint32 HighPriorityThreadCount = 6;
     platform_work_queue HighPriorityQueue;
-    Win32MakeQueue(&HighPriorityQueue, 6);
+    Win32MakeQueue(&HighPriorityQueue, HighPriorityThreadCount);
     platform_work_queue LowPriorityQueue;
     Win32MakeQueue(&LowPriorityQueue, 2);
 
@@ -1248,6 +1249,7 @@ int CALLBACK WinMain(HINSTANCE Instance, HINSTANCE PrevInstance, LPSTR CommandLi
     GameMemory.PlatformAPI.CompleteAllWork = Win32CompleteAllWork;
     GameMemory.HighPriorityQueue = &HighPriorityQueue;
     GameMemory.LowPriorityQueue = &LowPriorityQueue;
+    GameMemory.HighPriorityThreadCount = HighPriorityThreadCount;
 
     //* Timing
 
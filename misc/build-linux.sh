@@ -1,6 +1,7 @@
 mkdir -p build
 
-clang -shared -fpic -g -lm -DHANDMADE_INTERNAL=1 -DHANDMADE_SLOW=1 -DHANDMADE_LINUX=1 -Wno-null-dereference code/game/lib.cpp -o build/game_lib.so
-clang -g -lX11 -ldl -DHANDMADE_INTERNAL=1 -DHANDMADE_SLOW=1 -DHANDMADE_LINUX=1 -Wno-null-dereference code/linux/main.cpp -o build/linux_main
+clang -shared -fpic -g -lm -DHANDMADE_PROFILE=1 -DTRANSLATION_UNIT_INDEX=0 -DHANDMADE_INTERNAL=1 -DHANDMADE_SLOW=1 -DHANDMADE_LINUX=1 -Wno-null-dereference code/game/lib.cpp -o build/game_lib.so
+clang -g -lX11 -lXext -ldl -lpthread -DHANDMADE_INTERNAL=1 -DHANDMADE_SLOW=1 -DHANDMADE_LINUX=1 -Wno-null-dereference code/linux/main.cpp -o build/linux_main
+clang -g -ldl -lpthread -DHANDMADE_INTERNAL=1 -DHANDMADE_SLOW=1 -DHANDMADE_LINUX=1 -Wno-null-dereference code/linux/headless.cpp -o build/linux_headless
 
 echo Done